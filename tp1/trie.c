@@ -13,15 +13,20 @@
 #include <limits.h>
 #include <math.h>
 #include <string.h>
+#include <time.h>
+
+#include "trieStats.h"
 
 // Macros //////////////////////////////////////////////////////////////////////
-// Taille de l'alphabet égal à UCHAR_MAX
-#define ALPHABET_SIZE UCHAR_MAX
+// Taille de l'alphabet égal à UCHAR_MAX + 1 (toutes les valeurs d'un octet)
+#define ALPHABET_SIZE (UCHAR_MAX + 1)
 // Taux de remplissage
 #define FILL_RATE 0.75
 // Si 1, exécuter la version avec table de transitions. Sinon, exécuter la
 //  version avec table de hachage.
 #define HASH 1
+// Taille des blocs lus par le tokeniseur en flux
+#define TOKENIZER_BLOCK_SIZE 65536
 
 // Fonctions Outils ////////////////////////////////////////////////////////////
 /**
@@ -66,8 +71,8 @@ Trie createTrie(int maxNode) {
     // Initialisation des attributs
     // Nombre maximal de noeuds du trie
     trie->maxNode = maxNode;
-    // Indice du prochain noeud disponible
-    trie->nextNode = 0;
+    // Indice du prochain noeud disponible (le noeud 0 est la racine)
+    trie->nextNode = 1;
     // Table de transitions
     trie->transitions = malloc((long unsigned int) maxNode * sizeof(int *));
     // Test d'erreur
@@ -118,6 +123,10 @@ int insertInTrie(Trie trie, unsigned char *word) {
     for (i = 0; word[i] != 0; i++) {
         // Si la transition n'existe pas, on la crée
         if (trie->transitions[currentNode][word[i]] == -1) {
+            // Test de remplissage
+            if (trie->nextNode >= trie->maxNode) {
+                return -2;
+            }
             trie->transitions[currentNode][word[i]] = trie->nextNode;
             trie->nextNode++;
         }
@@ -168,6 +177,20 @@ int searchWord(Trie trie, unsigned char *w) {
     return trie->finite[currentNode];
 }
 
+/**
+ * DESCRIPTION:
+ *  Cible de la transition d'un noeud par une lettre.
+ * ARGUMENTS:
+ *  Trie trie : un trie à table de transitions.
+ *  int node : le noeud de départ.
+ *  unsigned char letter : l'étiquette de la transition.
+ * RETURN:
+ *  Le noeud cible, -1 si la transition n'existe pas.
+ */
+int findTransition(Trie trie, int node, unsigned char letter) {
+    return trie->transitions[node][letter];
+}
+
 /**
  * DESCRIPTION:
  *  Libération de la mémoire d'un trie à table de transitions.
@@ -195,6 +218,55 @@ int freeTrie(Trie trie) {
     return 0;
 }
 
+/**
+ * DESCRIPTION:
+ *  Statistiques de forme et d'occupation mémoire d'un trie à table de
+ *   transitions. Il n'y a pas de table de hachage : l'histogramme des
+ *   longueurs de chaînes reste vide.
+ * ARGUMENTS:
+ *  Trie trie : un trie à table de transitions.
+ *  TrieStats *stats : les statistiques à remplir.
+ * RETURN:
+ *  0 en cas de succès, -1 en cas d'erreur.
+ */
+int trieStats(Trie trie, TrieStats *stats) {
+    memset(stats, 0, sizeof(TrieStats));
+    int nodeCount = trie->nextNode;
+    // Père de chaque noeud
+    int *parent = malloc((size_t) nodeCount * sizeof(int));
+    if (parent == NULL) {
+        perror("Erreur d'allocation mémoire");
+        return -1;
+    }
+    memset(parent, -1, (size_t) nodeCount * sizeof(int));
+
+    // Parcours des lignes de la table de transitions des noeuds créés
+    for (int i = 0; i < nodeCount; i++) {
+        int children = 0;
+        for (int j = 0; j < ALPHABET_SIZE; j++) {
+            int target = trie->transitions[i][j];
+            if (target != -1) {
+                children++;
+                if (target < nodeCount) {
+                    parent[target] = i;
+                }
+            }
+        }
+        stats->transitionCount += children;
+        stats->fanOut[children]++;
+    }
+    stats->nodeCount = nodeCount;
+
+    // Une ligne de transitions et un état terminal par noeud
+    size_t nodeBytes = sizeof(int *) + ALPHABET_SIZE * sizeof(int) + sizeof(char);
+    stats->bytesAllocated = sizeof(struct _trie) + (size_t) trie->maxNode * nodeBytes;
+    stats->bytesUsed = sizeof(struct _trie) + (size_t) nodeCount * nodeBytes;
+
+    int err = fillDepthStats(parent, NULL, nodeCount, stats);
+    free(parent);
+    return err;
+}
+
 /**
  * DESCRIPTION:
  *  Affichage d'un trie à table de transitions.
@@ -250,7 +322,8 @@ typedef struct _list *List;
 struct _trie {
     int maxNode; // Nombre maximal de noeuds du trie
     int nextNode; // Indice du prochain noeud disponible
-    List *transition; // listes d'adjacence
+    int size; // Nombre d'alvéoles de la table de hachage
+    List *transition; // Table de hachage des transitions
     char *finite; // États terminaux  
 };
 
@@ -259,15 +332,11 @@ typedef struct _trie *Trie;
 ////////////////////////////////////////////////////////////////////////////////
 // Fonctions ///////////////////////////////////////////////////////////////////
 
-// Fonction de hashage avec nombres premiers
-int hash(unsigned char letter, unsigned char *word, int maxNode) {
-    int i = 0;
-    int hash = letter;
-    while (word[i] != '\0') {
-        hash = (hash * 31 + word[i]) % maxNode;
-        i++;
-    }
-    return hash;
+// Fonction de hachage d'une transition (noeud de départ, lettre). 257 est le
+//  premier nombre premier supérieur à la taille de l'alphabet, la clé
+//  node * 257 + letter est donc unique pour chaque transition.
+int hash(int node, unsigned char letter, int size) {
+    return (int) (((unsigned long) node * 257 + letter) % (unsigned long) size);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -294,31 +363,58 @@ Trie createTrie(int maxNode) {
     // Initialisation du trie
     // Nombre maximal de noeuds du trie
     trie->maxNode = maxNode;
-    // Indice du prochain noeud disponible
-    trie->nextNode = 0;
+    // Indice du prochain noeud disponible (le noeud 0 est la racine)
+    trie->nextNode = 1;
+    // Nombre d'alvéoles de la table de hachage
+    trie->size = (int) (maxNode * FILL_RATE);
+    if (trie->size < 1) {
+        trie->size = 1;
+    }
     // Table de hachage
-    trie->transition = malloc((size_t) (maxNode * FILL_RATE * sizeof(List)));
+    trie->transition = malloc((size_t) trie->size * sizeof(List));
     // Test d'erreur
     if (trie->transition == NULL) {
         perror("Erreur d'allocation mémoire");
         return NULL;
     }
     // Initialiser la liste de table de hachage avec NULL
-    memset(trie->transition, 0, (size_t) (maxNode * FILL_RATE * sizeof(List)));
-    // États terminaux
-    trie->finite = malloc((size_t) (maxNode * FILL_RATE * sizeof(char)));
+    memset(trie->transition, 0, (size_t) trie->size * sizeof(List));
+    // États terminaux (un par noeud)
+    trie->finite = malloc((size_t) maxNode * sizeof(char));
     // Test d'erreur
     if (trie->finite == NULL) {
         perror("Erreur d'allocation mémoire");
         return NULL;
     }
     // Initialiser les états terminaux avec 0
-    memset(trie->finite, 0, (size_t) (maxNode * FILL_RATE * sizeof(char)));
+    memset(trie->finite, 0, (size_t) maxNode * sizeof(char));
 
     return trie;
 
 }
 
+/**
+ * DESCRIPTION:
+ *  Cible de la transition d'un noeud par une lettre.
+ * ARGUMENTS:
+ *  Trie trie : un trie.
+ *  int node : le noeud de départ.
+ *  unsigned char letter : l'étiquette de la transition.
+ * RETURN:
+ *  Le noeud cible, -1 si la transition n'existe pas.
+ */
+int findTransition(Trie trie, int node, unsigned char letter) {
+    // On parcourt la liste de l'alvéole de la transition
+    List currentList = trie->transition[hash(node, letter, trie->size)];
+    while (currentList != NULL) {
+        if (currentList->startNode == node && currentList->letter == letter) {
+            return currentList->targetNode;
+        }
+        currentList = currentList->next;
+    }
+    return -1;
+}
+
 /**
  * DESCRIPTION:
  *  Ajout d'un mot dans un trie.
@@ -331,28 +427,21 @@ Trie createTrie(int maxNode) {
 int insertInTrie(Trie trie, unsigned char *word) {
 
     int i = 0;
-    int currentNode = hash(word[i], word, (int)(trie->maxNode * FILL_RATE));
+    int currentNode = 0;
     int nextNode = 0;
-    List currentList = NULL;
+    int bucket = 0;
     List newList = NULL;
     // Parcours du mot
     while (word[i] != '\0') {
-        // On récupère la liste d'adjacence du noeud courant
-        currentList = trie->transition[currentNode];
-        // On parcourt la liste d'adjacence
-        while (currentList != NULL) {
-            // Si la lettre de la transition est la même que la lettre du mot:
-            //  pas de création de noeud et on passe à la lettre suivante.
-            if (currentList->letter == word[i]) {
-                currentNode = currentList->targetNode;
-                break;
+        // Si la transition existe : pas de création de noeud et on passe à la
+        //  lettre suivante.
+        nextNode = findTransition(trie, currentNode, word[i]);
+        // Sinon, on crée un nouveau noeud.
+        if (nextNode == -1) {
+            // Test de remplissage
+            if (trie->nextNode >= trie->maxNode) {
+                return -2;
             }
-            // Sinon, on passe à la transition suivante
-            currentList = currentList->next;
-        }
-        // Si on a parcouru toute la liste d'adjacence sans trouver de
-        //  transition avec la lettre du mot, on crée un nouveau noeud.
-        if (currentList == NULL) {
             // Création d'un nouveau noeud
             nextNode = trie->nextNode;
             // On incrémente l'indice du prochain noeud disponible
@@ -364,14 +453,16 @@ int insertInTrie(Trie trie, unsigned char *word) {
                 perror("Erreur d'allocation mémoire");
                 return -1;
             }
-            // Initialisation de la nouvelle transition
+            // Initialisation de la nouvelle transition, ajoutée en tête de
+            //  son alvéole
+            bucket = hash(currentNode, word[i], trie->size);
             newList->startNode = currentNode;
             newList->targetNode = nextNode;
             newList->letter = word[i];
-            newList->next = trie->transition[currentNode];
-            trie->transition[currentNode] = newList;
-            currentNode = nextNode;
+            newList->next = trie->transition[bucket];
+            trie->transition[bucket] = newList;
         }
+        currentNode = nextNode;
         i++;
     }
     // On marque le noeud courant comme étant terminal
@@ -390,30 +481,14 @@ int insertInTrie(Trie trie, unsigned char *word) {
  *  1 si le mot est présent dans le trie, 0 sinon.
  */
 int searchWord(Trie trie, unsigned char *word) {
-    int i = 0;
-    int currentNode = hash(word[i], word, (int)(trie->maxNode * FILL_RATE));
-    List currentList = NULL;
+    int currentNode = 0;
     // Parcours du mot
-    while (word[i] != '\0') {
-        // On récupère la liste d'adjacence du noeud courant
-        currentList = trie->transition[currentNode];
-        // On parcourt la liste d'adjacence
-        while (currentList != NULL) {
-            // Si la lettre de la transition est la même que la lettre du mot:
-            //  pas de création de noeud et on passe à la lettre suivante.
-            if (currentList->letter == word[i]) {
-                currentNode = currentList->targetNode;
-                break;
-            }
-            // Sinon, on passe à la transition suivante
-            currentList = currentList->next;
-        }
-        // Si on a parcouru toute la liste d'adjacence sans trouver de
-        //  transition avec la lettre du mot, on retourne 0.
-        if (currentList == NULL) {
+    for (int i = 0; word[i] != '\0'; i++) {
+        currentNode = findTransition(trie, currentNode, word[i]);
+        // Si la transition n'existe pas, on retourne 0.
+        if (currentNode == -1) {
             return 0;
         }
-        i++;
     }
     // Si le noeud courant est terminal, on retourne 1.
     return trie->finite[currentNode];
@@ -430,7 +505,7 @@ int searchWord(Trie trie, unsigned char *word) {
 void freeTrie(Trie trie) {
     List currentList = NULL;
     List nextList = NULL;
-    for (int i = 0; i < trie->maxNode*FILL_RATE; i++) {
+    for (int i = 0; i < trie->size; i++) {
         currentList = trie->transition[i];
         while (currentList != NULL) {
             nextList = currentList->next;
@@ -445,6 +520,58 @@ void freeTrie(Trie trie) {
     free(trie);
 }
 
+/**
+ * DESCRIPTION:
+ *  Statistiques de forme et d'occupation mémoire d'un trie à table de
+ *   hachage.
+ * ARGUMENTS:
+ *  Trie trie : un trie.
+ *  TrieStats *stats : les statistiques à remplir.
+ * RETURN:
+ *  0 en cas de succès, -1 en cas d'erreur.
+ */
+int trieStats(Trie trie, TrieStats *stats) {
+    memset(stats, 0, sizeof(TrieStats));
+    int nodeCount = trie->nextNode;
+    // Père et nombre de fils de chaque noeud
+    int *parent = malloc((size_t) nodeCount * sizeof(int));
+    int *children = calloc((size_t) nodeCount, sizeof(int));
+    if (parent == NULL || children == NULL) {
+        perror("Erreur d'allocation mémoire");
+        free(parent);
+        free(children);
+        return -1;
+    }
+    memset(parent, -1, (size_t) nodeCount * sizeof(int));
+
+    // Parcours des alvéoles de la table de hachage
+    for (int i = 0; i < trie->size; i++) {
+        int chain = 0;
+        for (List currentList = trie->transition[i]; currentList != NULL; currentList = currentList->next) {
+            chain++;
+            children[currentList->startNode]++;
+            parent[currentList->targetNode] = currentList->startNode;
+        }
+        stats->transitionCount += chain;
+        stats->chainLength[chain < STATS_MAX_CHAIN ? chain : STATS_MAX_CHAIN - 1]++;
+    }
+    for (int i = 0; i < nodeCount; i++) {
+        stats->fanOut[children[i]]++;
+    }
+    stats->nodeCount = nodeCount;
+
+    // Les alvéoles, un maillon par transition et un état terminal par noeud
+    size_t fixedBytes = sizeof(struct _trie) + (size_t) trie->size * sizeof(List) \
+        + (size_t) stats->transitionCount * sizeof(struct _list);
+    stats->bytesAllocated = fixedBytes + (size_t) trie->maxNode * sizeof(char);
+    stats->bytesUsed = fixedBytes + (size_t) nodeCount * sizeof(char);
+
+    int err = fillDepthStats(parent, NULL, nodeCount, stats);
+    free(parent);
+    free(children);
+    return err;
+}
+
 /**
  * DESCRIPTION:
  *  Affichage d'un trie.
@@ -455,7 +582,7 @@ void freeTrie(Trie trie) {
  */
 void printTrie(Trie trie) {
     List currentList = NULL;
-    for (int i = 0; i < trie->nextNode; i++) {
+    for (int i = 0; i < trie->size; i++) {
         currentList = trie->transition[i];
         while (currentList != NULL) {
             printf("%d -> %d : %c, %d\n", currentList->startNode, \
@@ -620,6 +747,295 @@ int addFactors(Trie trie, unsigned char *word) {
     return 0;
 }
 
+/**
+ * DESCRIPTION:
+ *  Parcours du trie depuis la racine en suivant les lettres d'un texte, tant
+ *   que les transitions existent. On retient le dernier noeud terminal
+ *   rencontré.
+ * ARGUMENTS:
+ *  Trie trie : un trie.
+ *  unsigned char *text : un texte (pas nécessairement terminé par '\0').
+ *  int len : la longueur du texte.
+ *  int *truncated : mis à 1 si le parcours a atteint la fin du texte sans
+ *   sortir du trie (un mot plus long pourrait donc continuer après), 0 sinon.
+ * RETURN:
+ *  La longueur du plus long préfixe du texte qui est un mot du trie, -1 si
+ *   aucun préfixe du texte n'est un mot du trie.
+ */
+int walkPrefix(Trie trie, unsigned char *text, int len, int *truncated) {
+    int currentNode = 0;
+    // Le mot vide peut être dans le trie (cf. addPrefixes)
+    int longest = trie->finite[0] ? 0 : -1;
+    int i;
+    for (i = 0; i < len; i++) {
+        currentNode = findTransition(trie, currentNode, text[i]);
+        // Plus de transition : aucun mot plus long ne peut correspondre
+        if (currentNode == -1) {
+            break;
+        }
+        if (trie->finite[currentNode]) {
+            longest = i + 1;
+        }
+    }
+    *truncated = (i == len);
+    return longest;
+}
+
+/**
+ * DESCRIPTION:
+ *  Recherche du plus long préfixe d'un texte qui est un mot du trie, en un
+ *   seul parcours du trie (au lieu d'un appel à searchWord par préfixe).
+ * ARGUMENTS:
+ *  Trie trie : un trie.
+ *  unsigned char *text : un texte (pas nécessairement terminé par '\0').
+ *  int len : la longueur du texte.
+ * RETURN:
+ *  La longueur du plus long préfixe reconnu, -1 si aucun.
+ */
+int longestPrefix(Trie trie, unsigned char *text, int len) {
+    int truncated = 0;
+    return walkPrefix(trie, text, len, &truncated);
+}
+
+// Fonction appelée pour chaque lexème trouvé par tokenize. Le lexème pointe
+//  directement dans le texte (aucune allocation). known vaut 1 si le lexème
+//  est un mot du trie, 0 s'il s'agit d'un octet inconnu.
+typedef void (*TokenHandler)(unsigned char *token, int length, int known, void *data);
+
+/**
+ * DESCRIPTION:
+ *  Découpage glouton d'un bloc de texte en plus longs mots du trie. Un octet
+ *   qui ne commence aucun mot est rendu comme lexème inconnu d'un octet.
+ *  Le texte peut être fourni par blocs successifs : si le bloc n'est pas le
+ *   dernier, on s'arrête avant un lexème qui pourrait se prolonger dans le
+ *   bloc suivant. L'appelant reprend alors au premier octet non consommé.
+ *  Si le premier lexème du bloc peut lui-même se prolonger (un mot du trie
+ *   plus long que le bloc), rien n'est consommé : tokenize rend 0 pour
+ *   demander plus de données, et l'appelant doit rappeler tokenize avec un
+ *   bloc plus long commençant au même octet (cf. tokenizeBlocks). Le
+ *   découpage est ainsi le même, quelle que soit la taille des blocs.
+ * ARGUMENTS:
+ *  Trie trie : un trie.
+ *  unsigned char *text : le bloc de texte.
+ *  int len : la longueur du bloc.
+ *  int last : 1 si c'est le dernier bloc du flux, 0 sinon.
+ *  TokenHandler handler : fonction appelée pour chaque lexème.
+ *  void *data : donnée transmise à handler.
+ * RETURN:
+ *  Le nombre d'octets consommés : len si last vaut 1, 0 si le bloc doit être
+ *   prolongé avant de pouvoir rendre un lexème.
+ */
+int tokenize(Trie trie, unsigned char *text, int len, int last, TokenHandler handler, void *data) {
+    int i = 0;
+    int truncated = 0;
+    while (i < len) {
+        int n = walkPrefix(trie, text + i, len - i, &truncated);
+        // Le lexème pourrait se prolonger dans le bloc suivant : on le laisse
+        //  à l'appel suivant (i vaut 0 si c'est le premier du bloc)
+        if (truncated && !last) {
+            break;
+        }
+        if (n > 0) {
+            handler(text + i, n, 1, data);
+            i += n;
+        } else {
+            handler(text + i, 1, 0, data);
+            i++;
+        }
+    }
+    return i;
+}
+
+/**
+ * DESCRIPTION:
+ *  Découpage d'un texte en mémoire par blocs d'au plus blockSize octets,
+ *   comme s'il était lu en flux. Quand tokenize demande plus de données, le
+ *   bloc est doublé, puis revient à blockSize une fois le lexème rendu.
+ * ARGUMENTS:
+ *  Trie trie : un trie.
+ *  unsigned char *text : le texte.
+ *  int len : la longueur du texte.
+ *  int blockSize : la taille des blocs (au moins 1).
+ *  TokenHandler handler : fonction appelée pour chaque lexème.
+ *  void *data : donnée transmise à handler.
+ * RETURN:
+ *  void.
+ */
+void tokenizeBlocks(Trie trie, unsigned char *text, int len, int blockSize, TokenHandler handler, void *data) {
+    int pos = 0;
+    int currentSize = blockSize;
+    while (pos < len) {
+        int blockLength = len - pos < currentSize ? len - pos : currentSize;
+        int last = (pos + blockLength == len);
+        int consumed = tokenize(trie, text + pos, blockLength, last, handler, data);
+        if (consumed == 0) {
+            // Le premier lexème dépasse du bloc : on double le bloc (sans
+            //  dépasser la fin du texte)
+            currentSize = blockLength > (len - pos) / 2 ? len - pos : 2 * blockLength;
+        } else {
+            pos += consumed;
+            currentSize = blockSize;
+        }
+    }
+}
+
+// Compteurs du banc d'essai du tokeniseur
+struct _tokenCount {
+    long known; // Nombre de mots reconnus
+    long unknown; // Nombre d'octets inconnus
+};
+
+void countToken(unsigned char *token, int length, int known, void *data) {
+    struct _tokenCount *count = data;
+    (void) token;
+    (void) length;
+    if (known) {
+        count->known++;
+    } else {
+        count->unknown++;
+    }
+}
+
+// Lexèmes rendus par tokenize (les TOKEN_LIST_SIZE premiers), pour comparer
+//  deux découpages d'un même texte
+#define TOKEN_LIST_SIZE 64
+struct _tokenList {
+    int count; // Nombre de lexèmes (peut dépasser TOKEN_LIST_SIZE)
+    unsigned char *start[TOKEN_LIST_SIZE]; // Début de chaque lexème
+    int length[TOKEN_LIST_SIZE]; // Longueur de chaque lexème
+};
+
+void recordToken(unsigned char *token, int length, int known, void *data) {
+    struct _tokenList *list = data;
+    (void) known;
+    if (list->count < TOKEN_LIST_SIZE) {
+        list->start[list->count] = token;
+        list->length[list->count] = length;
+    }
+    list->count++;
+}
+
+/**
+ * DESCRIPTION:
+ *  Vérification du découpage par blocs quand un mot du trie est à cheval
+ *   sur plusieurs blocs : un mot de 26 lettres commence au 6e octet d'un
+ *   texte lu par blocs de 8 octets. Le découpage doit être le même que
+ *   celui du texte en un seul bloc.
+ * ARGUMENTS:
+ *  void.
+ * RETURN:
+ *  1 si les deux découpages sont identiques, 0 sinon, -1 en cas d'erreur.
+ */
+int checkTokenizer(void) {
+    Trie trie = createTrie(100);
+    if (trie == NULL) {
+        return -1;
+    }
+    unsigned char word1[] = "a";
+    unsigned char word2[] = "ab";
+    unsigned char word3[] = "xyz";
+    unsigned char word4[] = "abcdefghijklmnopqrstuvwxyz";
+    insertInTrie(trie, word1);
+    insertInTrie(trie, word2);
+    insertInTrie(trie, word3);
+    insertInTrie(trie, word4);
+
+    unsigned char text[] = "xyzababcdefghijklmnopqrstuvwxyzabxyz";
+    int len = length(text);
+    struct _tokenList whole = {0, {NULL}, {0}};
+    struct _tokenList blocks = {0, {NULL}, {0}};
+    tokenize(trie, text, len, 1, &recordToken, &whole);
+    tokenizeBlocks(trie, text, len, 8, &recordToken, &blocks);
+    freeTrie(trie);
+
+    int same = (whole.count == blocks.count);
+    for (int i = 0; same && i < whole.count && i < TOKEN_LIST_SIZE; i++) {
+        same = (whole.start[i] == blocks.start[i] && whole.length[i] == blocks.length[i]);
+    }
+    return same;
+}
+
+/**
+ * DESCRIPTION:
+ *  Banc d'essai du tokeniseur : un dictionnaire de wordCount mots aléatoires
+ *   et un texte de textLength octets formé de ces mots (avec un peu de bruit)
+ *   sont générés, puis le texte est découpé par blocs de
+ *   TOKENIZER_BLOCK_SIZE octets.
+ * ARGUMENTS:
+ *  int wordCount : nombre de mots du dictionnaire.
+ *  int textLength : longueur du texte.
+ * RETURN:
+ *  0 en cas de succès, -1 sinon.
+ */
+int benchTokenizer(int wordCount, int textLength) {
+    int maxWordLength = 8;
+    unsigned char *words = malloc((size_t) wordCount * (size_t) (maxWordLength + 1));
+    unsigned char *text = malloc((size_t) textLength);
+    Trie trie = createTrie(wordCount * maxWordLength + 1);
+    if (words == NULL || text == NULL || trie == NULL) {
+        perror("Erreur d'allocation mémoire");
+        free(words);
+        free(text);
+        return -1;
+    }
+
+    // Génération du dictionnaire
+    srand(42);
+    for (int w = 0; w < wordCount; w++) {
+        unsigned char *word = words + w * (maxWordLength + 1);
+        int n = 1 + rand() % maxWordLength;
+        for (int i = 0; i < n; i++) {
+            word[i] = (unsigned char) ('a' + rand() % 26);
+        }
+        word[n] = '\0';
+        if (insertInTrie(trie, word) != 0) {
+            fprintf(stderr, "Erreur d'insertion dans le trie\n");
+            freeTrie(trie);
+            free(words);
+            free(text);
+            return -1;
+        }
+    }
+
+    // Génération du texte : des mots du dictionnaire, et un octet de bruit
+    //  de temps en temps
+    int pos = 0;
+    while (pos < textLength) {
+        if (rand() % 16 == 0) {
+            text[pos++] = (unsigned char) (rand() % 256);
+            continue;
+        }
+        unsigned char *word = words + (rand() % wordCount) * (maxWordLength + 1);
+        for (int i = 0; word[i] != '\0' && pos < textLength; i++) {
+            text[pos++] = word[i];
+        }
+    }
+
+    // Découpage par blocs
+    struct _tokenCount count = {0, 0};
+    clock_t start = clock();
+    tokenizeBlocks(trie, text, textLength, TOKENIZER_BLOCK_SIZE, &countToken, &count);
+    clock_t end = clock();
+
+    double seconds = (double) (end - start) / CLOCKS_PER_SEC;
+    long tokens = count.known + count.unknown;
+    printf("Tokeniseur : %d octets, %ld lexèmes (%ld inconnus) en %f s\n", \
+        textLength, tokens, count.unknown, seconds);
+    if (seconds > 0) {
+        printf("Tokeniseur : %.0f lexèmes/s, %.1f Mo/s\n", (double) tokens / seconds, \
+            textLength / seconds / 1e6);
+    }
+    TrieStats stats;
+    if (trieStats(trie, &stats) == 0) {
+        printTrieStats(&stats);
+    }
+
+    freeTrie(trie);
+    free(words);
+    free(text);
+    return 0;
+}
+
 int main(void) {
     // test du trie
     Trie trie = createTrie(100);
@@ -693,4 +1109,30 @@ int main(void) {
     printf("Recherche de %s : %d\n", word12, searchWord(trie, word12));
     printf("Recherche de %s : %d\n", word13, searchWord(trie, word13));
     printf("Recherche de %s : %d\n", word14, searchWord(trie, word14));
+
+    freeTrie(trie);
+
+    // test du plus long préfixe
+    unsigned char text1[] = "testsABC";
+    unsigned char text2[] = "tesla";
+    trie = createTrie(100);
+    insertInTrie(trie, word1);
+    insertInTrie(trie, word5);
+    insertInTrie(trie, word6);
+    printf("Plus long préfixe de %s (5) : %d\n", text1, longestPrefix(trie, text1, length(text1)));
+    printf("Plus long préfixe de %s (3) : %d\n", text2, longestPrefix(trie, text2, length(text2)));
+    printf("Plus long préfixe de %s (-1) : %d\n", word9, longestPrefix(trie, word9, length(word9)));
+
+    // statistiques du trie
+    TrieStats stats;
+    if (trieStats(trie, &stats) == 0) {
+        printTrieStats(&stats);
+    }
+    freeTrie(trie);
+
+    // découpage par blocs d'un mot à cheval sur plusieurs blocs
+    printf("Découpage par blocs de 8 octets identique au découpage en un bloc (1) : %d\n", checkTokenizer());
+
+    // banc d'essai du tokeniseur
+    return benchTokenizer(2000, 8 * 1000 * 1000) == 0 ? 0 : 1;
 }
\ No newline at end of file
@@ -0,0 +1,153 @@
+/**
+ * FICHIER:
+ * --------
+ * trieStats.h
+ *
+ * DESCRIPTION:
+ * ------------
+ * Statistiques de forme et d'occupation mémoire d'un trie : nombre de noeuds
+ * et de transitions, octets alloués et utilisés, histogrammes du nombre de
+ * fils, de la longueur des chaînes de la table de hachage et de la
+ * profondeur des noeuds. Chaque implémentation remplit la structure avec sa
+ * propre fonction trieStats(). Ce fichier est utilisé par tp1 et par tp3.
+ *
+ * AUTEUR:
+ * -------
+ * M. TAIA
+ */
+
+#ifndef TRIE_STATS_H
+#define TRIE_STATS_H
+
+////////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+////////////////////////////////////////////////////////////////////////////////
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINES
+////////////////////////////////////////////////////////////////////////////////
+
+// Nombre de cases des histogrammes (la dernière case regroupe les valeurs
+//  supérieures)
+#define STATS_MAX_CHAIN 16
+#define STATS_MAX_DEPTH 64
+// Plus grand nombre de fils d'un noeud
+#define STATS_MAX_FAN_OUT (UCHAR_MAX + 1)
+
+
+////////////////////////////////////////////////////////////////////////////////
+// STRUCTURES
+////////////////////////////////////////////////////////////////////////////////
+
+// Statistiques de forme et d'occupation mémoire d'un trie
+struct _trieStats {
+    int nodeCount; // Nombre de noeuds
+    int transitionCount; // Nombre de transitions
+    size_t bytesAllocated; // Octets alloués par le trie
+    size_t bytesUsed; // Octets occupés par les noeuds et transitions existants
+    int fanOut[STATS_MAX_FAN_OUT + 1]; // Nombre de noeuds ayant i fils
+    int chainLength[STATS_MAX_CHAIN]; // Nombre d'alvéoles de longueur i
+    int depth[STATS_MAX_DEPTH]; // Nombre de noeuds à la profondeur i
+};
+
+typedef struct _trieStats TrieStats;
+
+
+////////////////////////////////////////////////////////////////////////////////
+// FONCTIONS
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * DESCRIPTION:
+ *  Calcul de la distribution des profondeurs à partir du père de chaque noeud.
+ *  La dernière case de l'histogramme regroupe les profondeurs supérieures.
+ * ARGUMENTS:
+ *  int *parent : père de chaque noeud, -1 pour une racine.
+ *  char *exists : 1 si le noeud existe, 0 sinon ; NULL si tous les noeuds
+ *   existent.
+ *  int nodeCount : taille des tableaux parent et exists.
+ *  TrieStats *stats : statistiques à compléter.
+ * RETURN:
+ *  0 en cas de succès, -1 en cas d'erreur.
+ */
+int fillDepthStats(int *parent, char *exists, int nodeCount, TrieStats *stats) {
+    // Profondeur de chaque noeud (-1 si pas encore calculée), et pile des
+    //  noeuds en attente de profondeur
+    int *depth = malloc((size_t) nodeCount * sizeof(int));
+    int *stack = malloc((size_t) nodeCount * sizeof(int));
+    if (depth == NULL || stack == NULL) {
+        perror("Erreur d'allocation mémoire");
+        free(depth);
+        free(stack);
+        return -1;
+    }
+    memset(depth, -1, (size_t) nodeCount * sizeof(int));
+
+    for (int i = 0; i < nodeCount; i++) {
+        // On remonte jusqu'à un ancêtre de profondeur connue ou une racine
+        int top = 0;
+        int node = i;
+        while (node != -1 && depth[node] == -1 && top < nodeCount) {
+            stack[top++] = node;
+            node = parent[node];
+        }
+        // Puis on redescend en fixant les profondeurs du chemin
+        int d = (node == -1) ? -1 : depth[node];
+        while (top > 0) {
+            depth[stack[--top]] = ++d;
+        }
+        if (exists == NULL || exists[i]) {
+            int bucket = depth[i] < STATS_MAX_DEPTH ? depth[i] : STATS_MAX_DEPTH - 1;
+            stats->depth[bucket]++;
+        }
+    }
+
+    free(depth);
+    free(stack);
+    return 0;
+}
+
+/**
+ * DESCRIPTION:
+ *  Affichage des statistiques d'un trie (les cases vides des histogrammes
+ *   ne sont pas affichées).
+ * ARGUMENTS:
+ *  TrieStats *stats : les statistiques d'un trie.
+ * RETURN:
+ *  void.
+ */
+void printTrieStats(TrieStats *stats) {
+    printf("Noeuds : %d\n", stats->nodeCount);
+    printf("Transitions : %d\n", stats->transitionCount);
+    printf("Octets alloués : %zu\n", stats->bytesAllocated);
+    printf("Octets utilisés : %zu\n", stats->bytesUsed);
+    printf("Nombre de fils (fils : noeuds) :");
+    for (int i = 0; i <= STATS_MAX_FAN_OUT; i++) {
+        if (stats->fanOut[i] != 0) {
+            printf(" %d:%d", i, stats->fanOut[i]);
+        }
+    }
+    printf("\n");
+    printf("Longueur des chaînes (longueur : alvéoles) :");
+    for (int i = 0; i < STATS_MAX_CHAIN; i++) {
+        if (stats->chainLength[i] != 0) {
+            printf(" %d%s:%d", i, i == STATS_MAX_CHAIN - 1 ? "+" : "", stats->chainLength[i]);
+        }
+    }
+    printf("\n");
+    printf("Profondeur (profondeur : noeuds) :");
+    for (int i = 0; i < STATS_MAX_DEPTH; i++) {
+        if (stats->depth[i] != 0) {
+            printf(" %d%s:%d", i, i == STATS_MAX_DEPTH - 1 ? "+" : "", stats->depth[i]);
+        }
+    }
+    printf("\n");
+}
+
+#endif
@@ -34,6 +34,10 @@
 ////////////////////////////////////////////////////////////////////////////////
 #include "config.h"
 #include "exactSearchAlgos.h"
+#include "fmIndex.h"
+#include "mappedText.h"
+#include "search.h"
+#include "suffixArray.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -44,6 +48,14 @@
 // DEFINES
 ////////////////////////////////////////////////////////////////////////////////
 
+////////////////////////////////////////////////////////////////////////////////
+// Variables globales
+////////////////////////////////////////////////////////////////////////////////
+// Nombre d'occurrences trouvées lors du dernier appel à measureTime (cumulé sur
+// tous les mots de la liste). Permet de vérifier que tous les algorithmes
+// trouvent les mêmes occurrences.
+long long occurrenceCount = 0;
+
 ////////////////////////////////////////////////////////////////////////////////
 // Fonctions
 ////////////////////////////////////////////////////////////////////////////////
@@ -95,69 +107,51 @@ int generateWordList(int wordListLength, int wordLength, int alphabetSize) {
 }
 
 /**
- * Fonction qui lit le texte dans le fichier demo_text.txt, et le stocke dans
- * la chaîne de caractères text.
- * Renvoie 0 en cas de succès, -1 sinon.
+ * Fonction qui cherche toutes les occurrences d'un mot dans un autre en
+ * utilisant l'algorithme pris en paramètre.
+ * L'algorithme pris en paramètre est la variante "Occurrences" d'un
+ * algorithme de recherche exacte : il prend en paramètre le texte et le mot à
+ * chercher, et rend toutes les occurrences du mot dans le texte en une seule
+ * passe.
  * 
- * @param text chaîne de caractères dans laquelle stocker le texte.
- * @return 0 en cas de succès, -1 sinon.
+ * @param algo algorithme de recherche exacte à utiliser.
+ * @param text texte dans lequel chercher le mot.
+ * @param word mot à chercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @return le nombre d'occurrences trouvées, -1 en cas d'erreur.
  */
-int readText(char* text, char* filename) {
-    // Ouverture du fichier.
-    FILE* file = fopen(filename, "r");
-    // Test d'erreur. Si l'ouverture a échoué, on renvoie -1.
-    if (file == NULL) {
-        return -1;
-    }
-    // Lecture du texte avec fgets et test d'erreur.
-    if (fgets(text, MAX_TEXT_LENGTH, file) == NULL) {
+long long runAlgo(long long (*algo)(char*, char*, ptrdiff_t, int, occurrenceCallback, void*), char* text, char* word, ptrdiff_t textLength, int wordLength) {
+    // Appel de l'algorithme, les occurrences sont seulement comptées.
+    long long count = algo(text, word, textLength, wordLength, NULL, NULL);
+    // Test d'erreur. Si l'algorithme a échoué, on renvoie -1.
+    if (count == -2) {
         return -1;
     }
-    // Fermeture du fichier.
-    fclose(file);
-    // Succès, on renvoie 0.
-    return 0;
+    // Succès, on renvoie le nombre d'occurrences.
+    return count;
 }
 
 /**
- * Fonction qui cherche toutes les occurrences d'un mot dans un autre en
- * utilisant l'algorithme pris en paramètre.
- * L'algorithme pris en paramètre prend en paramètre le texte, le mot à chercher
- * et rend l'indice de la première occurrence du mot dans le texte.
- * Il faut donc appeler l'algorithme tant qu'il renvoie un indice différent de
- * -1.
+ * Même fonction que runAlgo, mais pour un algorithme à tables précalculées,
+ * appelé sur un motif compilé compiledOccurrences(struct compiledPattern*
+ * pattern, int algoNum, ...).
  * 
- * @param algo algorithme de recherche exacte à utiliser.
+ * @param pattern motif compilé.
+ * @param algoNum numéro de l'algorithme (7, 8, 9, 10, 16 ou 17).
  * @param text texte dans lequel chercher le mot.
- * @param word mot à chercher dans le texte.
  * @param textLength longueur du texte.
- * @param wordLength longueur du mot.
- * @return 0 en cas de succès, -1 sinon.
+ * @return le nombre d'occurrences trouvées, -1 en cas d'erreur.
  */
-int runAlgo(int (*algo)(char*, char*, int, int), char* text, char* word, int textLength, int wordLength) {
-    // Initialisation de l'indice de la première occurrence.
-    int index = 0;
-    // Tant qu'on trouve une occurrence, on décale l'indice de la première
-    // occurrence
-    for (int i = 0; i < textLength - wordLength + 1; i++) {
-        // Appel de l'algorithme.
-        index = algo(text + i, word, textLength - i, wordLength);
-        // Test d'erreur. Si l'algorithme a échoué, on renvoie -1.
-        if (index == -2) {
-            return -1;
-        }
-        // Si l'algorithme a trouvé une occurrence, on décale l'indice de la
-        // première occurrence.
-        if (index != -1) {
-            i += index;
-        }
-        // Si aucune occurrence n'a été trouvée, on sort de la boucle.
-        else {
-            break;
-        }
+long long runAlgoCompiled(struct compiledPattern* pattern, int algoNum, char* text, ptrdiff_t textLength) {
+    // Appel de l'algorithme, les occurrences sont seulement comptées.
+    long long count = compiledOccurrences(pattern, algoNum, text, textLength, NULL, NULL);
+    // Test d'erreur. Si l'algorithme a échoué, on renvoie -1.
+    if (count == -2) {
+        return -1;
     }
-    // Succès, on renvoie 0.
-    return 0;
+    // Succès, on renvoie le nombre d'occurrences.
+    return count;
 }
 
 /**
@@ -196,17 +190,19 @@ double computeAverage(double* values, int length) {
  * @return temps moyen d'exécution de l'algorithme (en ms) en cas de succès,
  * -1 sinon.
  */
-double measureTime(int (*algo)(char*, char*, int, int), FILE* file, char* text, int textLength, int wordListLength, int wordLength) {
+double measureTime(long long (*algo)(char*, char*, ptrdiff_t, int, occurrenceCallback, void*), FILE* file, char* text, ptrdiff_t textLength, int wordListLength, int wordLength) {
     // Initialisations
-    int err = 0;
+    long long err = 0;
+    occurrenceCount = 0;
     // Tableau de temps d'exécution
     double times[wordListLength];
 
     // On lit chaque mot de la liste
     for (int i = 0; i < wordListLength; i++) {
         // On lit le mot
-        char word[wordLength + 1];
-        if (fgets(word, wordLength + 1, file) == NULL) {
+        // (wordLength + 2 pour lire aussi le retour à la ligne)
+        char word[wordLength + 2];
+        if (fgets(word, wordLength + 2, file) == NULL) {
             return -1;
         }
         // On mesure le temps d'exécution de l'algorithme
@@ -217,6 +213,8 @@ double measureTime(int (*algo)(char*, char*, int, int), FILE* file, char* text,
         if (err == -1) {
             return -1;
         }
+        // On compte les occurrences trouvées
+        occurrenceCount += err;
         // On stocke le temps d'exécution dans le tableau
         times[i] = (double) (end - start) / CLOCKS_PER_SEC * 1000;
     }
@@ -224,6 +222,246 @@ double measureTime(int (*algo)(char*, char*, int, int), FILE* file, char* text,
     return computeAverage(times, wordListLength);
 }
 
+/**
+ * Même fonction que measureTime, mais pour un algorithme à tables
+ * précalculées (MP, KMP, BM, Horspool, Turbo-BM, Apostolico-Giancarlo).
+ * Chaque mot est compilé une fois par compilePattern(), hors de la mesure,
+ * puis recherché avec compiledOccurrences().
+ * 
+ * @param algoNum numéro de l'algorithme (7, 8, 9, 10, 16 ou 17).
+ * @param file pointeur de fichier vers le fichier contenant la liste de mots.
+ * @param text texte dans lequel chercher les mots de la liste.
+ * @param textLength longueur du texte.
+ * @param wordListLength longueur de la liste de mots.
+ * @param wordLength longueur des mots de la liste.
+ * @return temps moyen d'exécution de l'algorithme (en ms) en cas de succès,
+ * -1 sinon.
+ */
+double measureTimeCompiled(int algoNum, FILE* file, char* text, ptrdiff_t textLength, int wordListLength, int wordLength) {
+    // Initialisations
+    long long err = 0;
+    occurrenceCount = 0;
+    // Tableau de temps d'exécution
+    double times[wordListLength];
+
+    // On lit chaque mot de la liste
+    for (int i = 0; i < wordListLength; i++) {
+        // On lit le mot
+        // (wordLength + 2 pour lire aussi le retour à la ligne)
+        char word[wordLength + 2];
+        if (fgets(word, wordLength + 2, file) == NULL) {
+            return -1;
+        }
+        // On compile le mot (toutes ses tables)
+        struct compiledPattern* pattern = compilePattern(word, wordLength);
+        if (pattern == NULL) {
+            return -1;
+        }
+        // On mesure le temps d'exécution de l'algorithme
+        clock_t start = clock();
+        err = runAlgoCompiled(pattern, algoNum, text, textLength);
+        clock_t end = clock();
+        freePattern(pattern);
+        // Test d'erreur
+        if (err == -1) {
+            return -1;
+        }
+        // On compte les occurrences trouvées
+        occurrenceCount += err;
+        // On stocke le temps d'exécution dans le tableau
+        times[i] = (double) (end - start) / CLOCKS_PER_SEC * 1000;
+    }
+    // On renvoie la moyenne des temps d'exécution
+    return computeAverage(times, wordListLength);
+}
+
+/**
+ * Fonction qui lit toute la liste de mots du fichier file. Les pointeurs et
+ * les mots sont rangés dans une seule allocation, à libérer par free().
+ * Renvoie la liste en cas de succès, NULL sinon.
+ * 
+ * @param file pointeur de fichier vers le fichier contenant la liste de mots.
+ * @param wordListLength longueur de la liste de mots.
+ * @param wordLength longueur des mots de la liste.
+ * @return la liste des mots en cas de succès, NULL sinon.
+ */
+char** readWordList(FILE* file, int wordListLength, int wordLength) {
+    // Allocation des pointeurs, suivis des mots
+    // (wordLength + 2 pour lire aussi le retour à la ligne).
+    char** words = malloc(sizeof(char*) * (size_t) wordListLength + (size_t) wordListLength * (size_t) (wordLength + 2));
+    // Test d'erreur. Si l'allocation a échoué, on renvoie NULL.
+    if (words == NULL) {
+        return NULL;
+    }
+    char* storage = (char*) (words + wordListLength);
+    // On lit chaque mot de la liste
+    for (int i = 0; i < wordListLength; i++) {
+        words[i] = storage + (size_t) i * (size_t) (wordLength + 2);
+        if (fgets(words[i], wordLength + 2, file) == NULL) {
+            free(words);
+            return NULL;
+        }
+    }
+    return words;
+}
+
+/**
+ * Même fonction que measureTime, mais pour la recherche multi-motifs
+ * multiKarpRabinOccurrences(char* text, ptrdiff_t textLength, char** words,
+ * int wordCount, int wordLength, ...).
+ * Toute la liste est recherchée en une seule passe sur le texte. Le temps
+ * renvoyé est le temps total divisé par wordListLength, pour être comparable
+ * au temps moyen par mot des autres algorithmes.
+ * 
+ * @param file pointeur de fichier vers le fichier contenant la liste de mots.
+ * @param text texte dans lequel chercher les mots de la liste.
+ * @param textLength longueur du texte.
+ * @param wordListLength longueur de la liste de mots.
+ * @param wordLength longueur des mots de la liste.
+ * @return temps moyen d'exécution par mot (en ms) en cas de succès, -1 sinon.
+ */
+double measureTimeMulti(FILE* file, char* text, ptrdiff_t textLength, int wordListLength, int wordLength) {
+    // Lecture de toute la liste.
+    char** words = readWordList(file, wordListLength, wordLength);
+    if (words == NULL) {
+        return -1;
+    }
+    // On mesure le temps d'exécution de l'algorithme
+    clock_t start = clock();
+    long long count = multiKarpRabinOccurrences(text, textLength, words, wordListLength, wordLength, NULL, NULL);
+    clock_t end = clock();
+    free(words);
+    // Test d'erreur
+    if (count == -2) {
+        return -1;
+    }
+    // On compte les occurrences trouvées
+    occurrenceCount = count;
+    // On renvoie le temps par mot
+    return (double) (end - start) / CLOCKS_PER_SEC * 1000 / wordListLength;
+}
+
+/**
+ * Même fonction que measureTimeMulti, mais pour l'algo Wu-Manber
+ * wuManberOccurrences(char* text, ptrdiff_t textLength, char** words,
+ * int* wordLengths, int wordCount, ...).
+ * 
+ * @param file pointeur de fichier vers le fichier contenant la liste de mots.
+ * @param text texte dans lequel chercher les mots de la liste.
+ * @param textLength longueur du texte.
+ * @param wordListLength longueur de la liste de mots.
+ * @param wordLength longueur des mots de la liste.
+ * @return temps moyen d'exécution par mot (en ms) en cas de succès, -1 sinon.
+ */
+double measureTimeWuManber(FILE* file, char* text, ptrdiff_t textLength, int wordListLength, int wordLength) {
+    // Lecture de toute la liste.
+    char** words = readWordList(file, wordListLength, wordLength);
+    if (words == NULL) {
+        return -1;
+    }
+    // Tous les mots de la liste ont la même longueur.
+    int* wordLengths = malloc(sizeof(int) * (size_t) wordListLength);
+    if (wordLengths == NULL) {
+        free(words);
+        return -1;
+    }
+    for (int i = 0; i < wordListLength; i++) {
+        wordLengths[i] = wordLength;
+    }
+    // On mesure le temps d'exécution de l'algorithme
+    clock_t start = clock();
+    long long count = wuManberOccurrences(text, textLength, words, wordLengths, wordListLength, NULL, NULL);
+    clock_t end = clock();
+    free(wordLengths);
+    free(words);
+    // Test d'erreur
+    if (count == -2) {
+        return -1;
+    }
+    // On compte les occurrences trouvées
+    occurrenceCount = count;
+    // On renvoie le temps par mot
+    return (double) (end - start) / CLOCKS_PER_SEC * 1000 / wordListLength;
+}
+
+
+/**
+ * Même fonction que measureTime, mais pour l'index du texte (tableau des
+ * suffixes, voir suffixArray.h) : l'index est construit une fois, puis
+ * chaque mot de la liste est compté avec suffixArrayCount(). Le temps de
+ * construction est réparti sur les mots de la liste, pour comparer l'index
+ * aux algorithmes qui relisent le texte à chaque mot.
+ * 
+ * @param file pointeur de fichier vers le fichier contenant la liste de mots.
+ * @param text texte dans lequel chercher les mots de la liste.
+ * @param textLength longueur du texte.
+ * @param wordListLength longueur de la liste de mots.
+ * @param wordLength longueur des mots de la liste.
+ * @return temps moyen par mot, construction comprise (en ms) en cas de
+ * succès, -1 sinon.
+ */
+double measureTimeSuffixArray(FILE* file, char* text, ptrdiff_t textLength, int wordListLength, int wordLength) {
+    // Lecture de toute la liste.
+    char** words = readWordList(file, wordListLength, wordLength);
+    if (words == NULL) {
+        return -1;
+    }
+    // On mesure le temps de construction de l'index et des requêtes
+    occurrenceCount = 0;
+    clock_t start = clock();
+    struct suffixArray* index = buildSuffixArray(text, textLength);
+    if (index == NULL) {
+        free(words);
+        return -1;
+    }
+    for (int i = 0; i < wordListLength; i++) {
+        occurrenceCount += suffixArrayCount(index, words[i], wordLength);
+    }
+    clock_t end = clock();
+    freeSuffixArray(index);
+    free(words);
+    // On renvoie le temps par mot
+    return (double) (end - start) / CLOCKS_PER_SEC * 1000 / wordListLength;
+}
+
+/**
+ * Même fonction que measureTimeSuffixArray, mais pour l'index compressé du
+ * texte (index FM, voir fmIndex.h) : les mots sont comptés avec
+ * fmIndexCount().
+ * 
+ * @param file pointeur de fichier vers le fichier contenant la liste de mots.
+ * @param text texte dans lequel chercher les mots de la liste.
+ * @param textLength longueur du texte.
+ * @param wordListLength longueur de la liste de mots.
+ * @param wordLength longueur des mots de la liste.
+ * @return temps moyen par mot, construction comprise (en ms) en cas de
+ * succès, -1 sinon.
+ */
+double measureTimeFmIndex(FILE* file, char* text, ptrdiff_t textLength, int wordListLength, int wordLength) {
+    // Lecture de toute la liste.
+    char** words = readWordList(file, wordListLength, wordLength);
+    if (words == NULL) {
+        return -1;
+    }
+    // On mesure le temps de construction de l'index et des requêtes
+    occurrenceCount = 0;
+    clock_t start = clock();
+    struct fmIndex* index = buildFmIndex(text, textLength, FM_SAMPLE_RATE);
+    if (index == NULL) {
+        free(words);
+        return -1;
+    }
+    for (int i = 0; i < wordListLength; i++) {
+        occurrenceCount += fmIndexCount(index, words[i], wordLength);
+    }
+    clock_t end = clock();
+    freeFmIndex(index);
+    free(words);
+    // On renvoie le temps par mot
+    return (double) (end - start) / CLOCKS_PER_SEC * 1000 / wordListLength;
+}
+
+
 /**
  * Fonction qui lit la liste de mots dans le fichier demo_wordList.txt, et
  * mesure le temps moyen d'exécution de chaque algorithme de recherche exacte.
@@ -239,7 +477,7 @@ double measureTime(int (*algo)(char*, char*, int, int), FILE* file, char* text,
  * @param file pointeur de fichier vers le fichier contenant la liste de mots.
  * @return 0 en cas de succès, -1 sinon.
  */
-double testAlgos(char* text, int textLength, int wordListLength, int wordLength, int algoNum, char* listfname) {
+double testAlgos(char* text, ptrdiff_t textLength, int wordListLength, int wordLength, int algoNum, char* listfname) {
     // Ouverture du fichier.
     FILE* file = fopen(listfname, "r");
     // Test d'erreur. Si l'ouverture a échoué, on renvoie -1.
@@ -256,7 +494,7 @@ double testAlgos(char* text, int textLength, int wordListLength, int wordLength,
         case 1:
             // Mesure du temps d'exécution de l'algorithme naïf, sans boucle rapide, sans sentinelle.
             // printf("Algo naïf, sans boucle rapide, sans sentinelle : ");
-            err = measureTime(&naif, file, text, textLength, wordListLength, wordLength);
+            err = measureTime(&naifOccurrences, file, text, textLength, wordListLength, wordLength);
             // Test d'erreur. Si la mesure a échoué, on renvoie -1.
             if (err == -1) {
                 return -1;
@@ -268,7 +506,7 @@ double testAlgos(char* text, int textLength, int wordListLength, int wordLength,
         case 2:
             // Mesure du temps d'exécution de l'algorithme naïf, avec boucle rapide, sans sentinelle.
             // printf("Algo naïf, avec boucle rapide, sans sentinelle : ");
-            err = measureTime(&naifBoucleRapide, file, text, textLength, wordListLength, wordLength);
+            err = measureTime(&naifBoucleRapideOccurrences, file, text, textLength, wordListLength, wordLength);
             // Test d'erreur. Si la mesure a échoué, on renvoie -1.
             if (err == -1) {
                 return -1;
@@ -280,7 +518,7 @@ double testAlgos(char* text, int textLength, int wordListLength, int wordLength,
         case 3:
             // Mesure du temps d'exécution de l'algorithme naïf, avec boucle rapide, avec sentinelle.
             // printf("Algo naïf, avec boucle rapide, avec sentinelle : ");
-            err = measureTime(&naifSentinelle, file, text, textLength, wordListLength, wordLength);
+            err = measureTime(&naifSentinelleOccurrences, file, text, textLength, wordListLength, wordLength);
             // Test d'erreur. Si la mesure a échoué, on renvoie -1.
             if (err == -1) {
                 return -1;
@@ -292,7 +530,7 @@ double testAlgos(char* text, int textLength, int wordListLength, int wordLength,
         case 4:
             // Mesure du temps d'exécution de l'algorithme naïf avec strncmp, sans boucle rapide, sans sentinelle.
             // printf("Algo naïf avec strncmp, sans boucle rapide, sans sentinelle : ");
-            err = measureTime(&naifStrncmp, file, text, textLength, wordListLength, wordLength);
+            err = measureTime(&naifStrncmpOccurrences, file, text, textLength, wordListLength, wordLength);
             // Test d'erreur. Si la mesure a échoué, on renvoie -1.
             if (err == -1) {
                 return -1;
@@ -304,7 +542,7 @@ double testAlgos(char* text, int textLength, int wordListLength, int wordLength,
         case 5:
             // Mesure du temps d'exécution de l'algorithme naïf avec strncmp, avec boucle rapide, sans sentinelle.
             // printf("Algo naïf avec strncmp, avec boucle rapide, sans sentinelle : ");
-            err = measureTime(&naifRapideStrncmp, file, text, textLength, wordListLength, wordLength);
+            err = measureTime(&naifRapideStrncmpOccurrences, file, text, textLength, wordListLength, wordLength);
             // Test d'erreur. Si la mesure a échoué, on renvoie -1.
             if (err == -1) {
                 return -1;
@@ -316,7 +554,7 @@ double testAlgos(char* text, int textLength, int wordListLength, int wordLength,
         case 6:
             // Mesure du temps d'exécution de l'algorithme naïf avec strncmp, avec boucle rapide, avec sentinelle.
             // printf("Algo naïf avec strncmp, avec boucle rapide, avec sentinelle : ");
-            err = measureTime(&naifSentinelleStrncmp, file, text, textLength, wordListLength, wordLength);
+            err = measureTime(&naifSentinelleStrncmpOccurrences, file, text, textLength, wordListLength, wordLength);
             // Test d'erreur. Si la mesure a échoué, on renvoie -1.
             if (err == -1) {
                 return -1;
@@ -325,6 +563,186 @@ double testAlgos(char* text, int textLength, int wordListLength, int wordLength,
             // printf("%f (ms)\n", err);
             return err;
             break;
+        case 7:
+            // Mesure du temps d'exécution de l'algorithme Morris-Pratt.
+            err = measureTimeCompiled(7, file, text, textLength, wordListLength, wordLength);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (err == -1) {
+                return -1;
+            }
+            return err;
+            break;
+        case 8:
+            // Mesure du temps d'exécution de l'algorithme Knuth-Morris-Pratt.
+            err = measureTimeCompiled(8, file, text, textLength, wordListLength, wordLength);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (err == -1) {
+                return -1;
+            }
+            return err;
+            break;
+        case 9:
+            // Mesure du temps d'exécution de l'algorithme Boyer-Moore.
+            err = measureTimeCompiled(9, file, text, textLength, wordListLength, wordLength);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (err == -1) {
+                return -1;
+            }
+            return err;
+            break;
+        case 10:
+            // Mesure du temps d'exécution de l'algorithme Horspool.
+            err = measureTimeCompiled(10, file, text, textLength, wordListLength, wordLength);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (err == -1) {
+                return -1;
+            }
+            return err;
+            break;
+        case 11:
+            // Mesure du temps d'exécution de l'algorithme naïf vectorisé.
+            err = measureTime(&naifSimdOccurrences, file, text, textLength, wordListLength, wordLength);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (err == -1) {
+                return -1;
+            }
+            return err;
+            break;
+        case 12:
+            // Mesure du temps d'exécution de l'algorithme Two-Way.
+            err = measureTime(&twoWayOccurrences, file, text, textLength, wordListLength, wordLength);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (err == -1) {
+                return -1;
+            }
+            return err;
+            break;
+        case 13:
+            // Mesure du temps d'exécution de l'algorithme Shift-Or.
+            err = measureTime(&shiftOrOccurrences, file, text, textLength, wordListLength, wordLength);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (err == -1) {
+                return -1;
+            }
+            return err;
+            break;
+        case 14:
+            // Mesure du temps d'exécution de l'algorithme BNDM.
+            err = measureTime(&bndmOccurrences, file, text, textLength, wordListLength, wordLength);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (err == -1) {
+                return -1;
+            }
+            return err;
+            break;
+        case 15:
+            // Mesure du temps d'exécution de l'algorithme BOM.
+            err = measureTime(&bomOccurrences, file, text, textLength, wordListLength, wordLength);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (err == -1) {
+                return -1;
+            }
+            return err;
+            break;
+        case 16:
+            // Mesure du temps d'exécution de l'algorithme Turbo-BM.
+            err = measureTimeCompiled(16, file, text, textLength, wordListLength, wordLength);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (err == -1) {
+                return -1;
+            }
+            return err;
+            break;
+        case 17:
+            // Mesure du temps d'exécution de l'algorithme Apostolico-Giancarlo.
+            err = measureTimeCompiled(17, file, text, textLength, wordListLength, wordLength);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (err == -1) {
+                return -1;
+            }
+            return err;
+            break;
+        case 18:
+            // Mesure du temps d'exécution de l'algorithme Karp-Rabin.
+            err = measureTime(&karpRabinOccurrences, file, text, textLength, wordListLength, wordLength);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (err == -1) {
+                return -1;
+            }
+            return err;
+            break;
+        case 19:
+            // Mesure du temps d'exécution de l'algorithme multi-motifs (Karp-Rabin).
+            err = measureTimeMulti(file, text, textLength, wordListLength, wordLength);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (err == -1) {
+                return -1;
+            }
+            return err;
+            break;
+        case 20:
+            // Mesure du temps d'exécution de l'algorithme Wu-Manber.
+            err = measureTimeWuManber(file, text, textLength, wordListLength, wordLength);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (err == -1) {
+                return -1;
+            }
+            return err;
+            break;
+        case 21:
+            // Mesure du temps d'exécution de l'algorithme Quick Search.
+            err = measureTime(&quickSearchOccurrences, file, text, textLength, wordListLength, wordLength);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (err == -1) {
+                return -1;
+            }
+            return err;
+            break;
+        case 22:
+            // Mesure du temps d'exécution de l'algorithme Raita.
+            err = measureTime(&raitaOccurrences, file, text, textLength, wordListLength, wordLength);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (err == -1) {
+                return -1;
+            }
+            return err;
+            break;
+        case 23:
+            // Mesure du temps d'exécution de l'algorithme Horspool optimisé.
+            err = measureTime(&horspoolOptimiseOccurrences, file, text, textLength, wordListLength, wordLength);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (err == -1) {
+                return -1;
+            }
+            return err;
+            break;
+        case 24:
+            // Mesure du temps d'exécution de l'algorithme search (choix automatique).
+            err = measureTime(&search, file, text, textLength, wordListLength, wordLength);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (err == -1) {
+                return -1;
+            }
+            return err;
+            break;
+        case 25:
+            // Mesure du temps de l'index (tableau des suffixes), construction comprise.
+            err = measureTimeSuffixArray(file, text, textLength, wordListLength, wordLength);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (err == -1) {
+                return -1;
+            }
+            return err;
+            break;
+        case 26:
+            // Mesure du temps de l'index FM, construction comprise.
+            err = measureTimeFmIndex(file, text, textLength, wordListLength, wordLength);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (err == -1) {
+                return -1;
+            }
+            return err;
+            break;
         // fin du match case.
     }
     // Fermeture du fichier.
@@ -377,6 +795,10 @@ int main(int argc, char** argv) {
         return -1;
     }
 
+    // Chargement du profil de search(), s'il a été calibré (sinon, profil
+    // par défaut).
+    loadSearchProfile(SEARCH_PROFILE_FILE);
+
     // Génération du texte et de la liste de mots.
     if (generateText(textLength, alphabetSize) == -1) {
         fprintf(stderr, "Erreur lors de la génération du texte.\n");
@@ -386,15 +808,19 @@ int main(int argc, char** argv) {
         fprintf(stderr, "Erreur lors de la génération de la liste de mots.\n");
         return -1;
     }
-    // Lecture du texte.
-    char text[MAX_TEXT_LENGTH];
-    if (readText(text, textFilename) == -1) {
+    // Projection du texte en mémoire, modifiable et suivie d'un octet pour la
+    // sentinelle des algorithmes 3 et 6.
+    struct mappedText mapped;
+    if (mapText(textFilename, 1, MAPPED_TEXT_WRITABLE | MAPPED_TEXT_HUGE_PAGES, &mapped) == -1) {
         fprintf(stderr, "Erreur lors de la lecture du texte.\n");
         return -1;
     }
+    char* text = mapped.text;
+    ptrdiff_t mappedLength = (ptrdiff_t) mapped.length;
 
     // Tests des algos
-    double result = testAlgos(text, textLength, wordListLength, wordLength, algoNum, listFilename);
+    double result = testAlgos(text, mappedLength, wordListLength, wordLength, algoNum, listFilename);
+    unmapText(&mapped);
     if (result == -1) {
         fprintf(stderr, "Erreur lors du test des algos.\n");
         return -1;
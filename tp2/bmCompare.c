@@ -0,0 +1,213 @@
+/**
+ * FICHIER:
+ * --------
+ * bmCompare.c
+ *
+ * DESCRIPTION:
+ * ------------
+ * Programme qui compare Boyer-Moore, Turbo-BM et Apostolico-Giancarlo sur un
+ * texte aléatoire et sur des textes périodiques (faible entropie).
+ *
+ * Sur un texte aléatoire, les trois algorithmes font à peu près le même
+ * nombre de comparaisons. Le Boyer-Moore de exactSearchAlgos.h applique la
+ * règle de Galil : il reste linéaire sur a^m dans a^n, où le mot apparaît à
+ * chaque position. Les bornes diffèrent en revanche par leur constante : au
+ * plus 3n comparaisons pour Boyer-Moore, 2n pour Turbo-BM et 1,5n pour
+ * Apostolico-Giancarlo. Le mot a^k b a^k dans le texte périodique
+ * (a^(k+1) b)^* approche ces bornes quand k grandit.
+ *
+ * Le même fichier donne deux programmes (voir le Makefile) : bmCompare mesure
+ * le temps d'exécution, bmComparisons est compilé avec COUNT_COMPARISONS et
+ * compte les comparaisons de caractères (voir COMPARE dans
+ * exactSearchAlgos.h). Les temps de bmComparisons ne sont pas significatifs,
+ * ce programme ne les affiche donc pas.
+ *
+ * Exemple : ./bmCompare 1000000 32 ; ./bmComparisons 1000000 32
+ *
+ * AUTEUR:
+ * -------
+ * M. TAIA
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+////////////////////////////////////////////////////////////////////////////////
+#include "config.h"
+#include "exactSearchAlgos.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINES
+////////////////////////////////////////////////////////////////////////////////
+// Nombre de mots recherchés dans le texte aléatoire.
+#define RANDOM_WORDS 20
+// Taille de l'alphabet du texte aléatoire.
+#define RANDOM_ALPHABET_SIZE 4
+// Nombre de cas mesurés (texte aléatoire, puis textes périodiques).
+#define NB_CASES 3
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables globales
+////////////////////////////////////////////////////////////////////////////////
+// Algorithmes comparés (numéros de compiledOccurrences()) et leurs noms.
+int algoNums[] = {9, 16, 17};
+const char* algoNames[] = {"Boyer-Moore", "Turbo-BM", "Apostolico-Giancarlo"};
+
+////////////////////////////////////////////////////////////////////////////////
+// Fonctions
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Fonction qui remplit une chaîne de caractères aléatoires sur un alphabet de
+ * taille donnée (mêmes lettres que singleStringText_generator).
+ *
+ * @param s chaîne à remplir.
+ * @param length longueur de la chaîne.
+ * @param alphabetSize taille de l'alphabet.
+ */
+void randomString(char* s, int length, int alphabetSize) {
+    for (int i = 0; i < length; i++) {
+        s[i] = (char) (rand() % alphabetSize + '!');
+    }
+    s[length] = '\0';
+}
+
+/**
+ * Fonction qui remplit une chaîne avec des blocs de a séparés par des b : la
+ * chaîne est a^k b a^k b ..., où k = period - 1 (a^n si period vaut 0).
+ *
+ * @param s chaîne à remplir.
+ * @param length longueur de la chaîne.
+ * @param period longueur d'un bloc a^k b, ou 0.
+ */
+void periodicString(char* s, int length, int period) {
+    for (int i = 0; i < length; i++) {
+        s[i] = period > 0 && i % period == period - 1 ? 'b' : 'a';
+    }
+    s[length] = '\0';
+}
+
+/**
+ * Fonction qui recherche chaque mot de la liste dans le texte avec un
+ * algorithme de compiledOccurrences(), et affiche le temps total (en ms), ou,
+ * si COUNT_COMPARISONS est défini, le nombre de comparaisons de caractères et
+ * ce nombre rapporté à la longueur du texte.
+ * Renvoie 0 en cas de succès, -1 sinon.
+ *
+ * @param a indice de l'algorithme dans algoNums.
+ * @param text texte dans lequel rechercher les mots.
+ * @param textLength longueur du texte.
+ * @param words mots à rechercher, de wordLength caractères, rangés tous les
+ *              MAX_WORD_LENGTH + 1 caractères.
+ * @param nbWords nombre de mots.
+ * @param wordLength longueur des mots.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int compareAlgorithm(int a, char* text, int textLength, char* words, int nbWords, int wordLength) {
+    long long occurrences = 0;
+#ifdef COUNT_COMPARISONS
+    comparisonCount = 0;
+#endif
+    clock_t start = clock();
+    for (int w = 0; w < nbWords; w++) {
+        struct compiledPattern* pattern = compilePattern(words + w * (MAX_WORD_LENGTH + 1), wordLength);
+        // Test d'erreur. Si la compilation a échoué, on renvoie -1.
+        if (pattern == NULL) {
+            return -1;
+        }
+        long long count = compiledOccurrences(pattern, algoNums[a], text, textLength, NULL, NULL);
+        freePattern(pattern);
+        // Test d'erreur. Si la recherche a échoué, on renvoie -1.
+        if (count < 0) {
+            return -1;
+        }
+        occurrences += count;
+    }
+    clock_t end = clock();
+#ifdef COUNT_COMPARISONS
+    (void) start;
+    (void) end;
+    printf("  %-21s: %ld comparaisons, %.2f par caractère (%lld occurrences)\n", algoNames[a], comparisonCount,
+           (double) comparisonCount / ((double) textLength * nbWords), occurrences);
+#else
+    printf("  %-21s: %f (ms) (%lld occurrences)\n", algoNames[a], (double) (end - start) / CLOCKS_PER_SEC * 1000,
+           occurrences);
+#endif
+    return 0;
+}
+
+/**
+ * Fonction principale.
+ *
+ * @param argc nombre d'arguments.
+ * @param argv arguments.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int main(int argc, char** argv) {
+    // Test du nombre d'arguments.
+    if (argc != 3) {
+        printf("Usage : %s textLength wordLength\n", argv[0]);
+        return -1;
+    }
+
+    // Récupération et test des arguments.
+    int textLength = atoi(argv[1]);
+    int wordLength = atoi(argv[2]);
+    if (textLength < 1 || textLength > MAX_TEXT_LENGTH) {
+        fprintf(stderr, "La longueur du texte doit être comprise entre 1 et %d.\n", MAX_TEXT_LENGTH);
+        return -1;
+    }
+    if (wordLength < 3 || wordLength > MAX_WORD_LENGTH) {
+        fprintf(stderr, "La longueur des mots doit être comprise entre 3 et %d.\n", MAX_WORD_LENGTH);
+        return -1;
+    }
+
+    char* text = malloc((size_t) textLength + 1);
+    char* words = malloc(RANDOM_WORDS * (MAX_WORD_LENGTH + 1));
+    // Test d'erreur. Si une allocation a échoué, on renvoie -1.
+    if (text == NULL || words == NULL) {
+        fprintf(stderr, "Erreur lors de l'allocation.\n");
+        free(text);
+        free(words);
+        return -1;
+    }
+
+    // Cas mesurés : un texte aléatoire, a^m dans a^n (une occurrence à chaque
+    // position), puis a^k b a^k (k = (m - 1) / 2) dans (a^(k+1) b)^*.
+    const char* caseNames[NB_CASES] = {"Texte aléatoire (alphabet de 4 lettres)", "a^m dans a^n",
+                                       "a^k b a^k dans (a^(k+1) b)^*"};
+    int k = (wordLength - 1) / 2;
+    int err = 0;
+    for (int c = 0; err == 0 && c < NB_CASES; c++) {
+        int nbWords = 1;
+        if (c == 0) {
+            randomString(text, textLength, RANDOM_ALPHABET_SIZE);
+            for (int w = 0; w < RANDOM_WORDS; w++) {
+                randomString(words + w * (MAX_WORD_LENGTH + 1), wordLength, RANDOM_ALPHABET_SIZE);
+            }
+            nbWords = RANDOM_WORDS;
+        } else if (c == 1) {
+            periodicString(text, textLength, 0);
+            periodicString(words, wordLength, 0);
+        } else {
+            periodicString(text, textLength, k + 2);
+            periodicString(words, 2 * k + 1, k + 1);
+        }
+        printf("%s, n = %d, m = %d :\n", caseNames[c], textLength, c == 2 ? 2 * k + 1 : wordLength);
+        for (int a = 0; err == 0 && a < (int) (sizeof(algoNums) / sizeof(algoNums[0])); a++) {
+            err = compareAlgorithm(a, text, textLength, words, nbWords, c == 2 ? 2 * k + 1 : wordLength);
+        }
+    }
+
+    free(text);
+    free(words);
+    // Test d'erreur. Si une recherche a échoué, on renvoie -1.
+    if (err == -1) {
+        fprintf(stderr, "Erreur lors de la recherche.\n");
+        return -1;
+    }
+    return 0;
+}
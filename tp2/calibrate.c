@@ -0,0 +1,225 @@
+/**
+ * FICHIER:
+ * --------
+ * calibrate.c
+ *
+ * DESCRIPTION:
+ * ------------
+ * Programme de calibration de search() (voir search.h).
+ *
+ * Pour chaque classe de taille d'alphabet et de longueur de mot du profil de
+ * recherche, le programme génère un texte et des mots aléatoires (comme
+ * singleStringText_generator et wordList_generator), mesure sur la machine
+ * chaque algorithme utilisable par search(), et retient le plus rapide. Il
+ * mesure aussi la longueur de texte en dessous de laquelle l'algorithme naïf
+ * reste le plus rapide. Le profil obtenu est écrit dans le fichier donné en
+ * paramètre (par défaut searchProfile.txt), que loadSearchProfile() charge.
+ *
+ * AUTEUR:
+ * -------
+ * M. TAIA
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+////////////////////////////////////////////////////////////////////////////////
+#include "config.h"
+#include "search.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINES
+////////////////////////////////////////////////////////////////////////////////
+// Longueur du texte de calibration (celle de runTests.sh).
+#define CALIBRATION_TEXT_LENGTH 500000
+// Nombre de mots mesurés par case de la table.
+#define CALIBRATION_WORDS 20
+// Plus grand numéro d'algorithme de exactSearchAlgos.h.
+#define MAX_ALGO_NUM 23
+// Nombre de répétitions pour la mesure des petits textes.
+#define SMALL_TEXT_REPEAT 20000
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables globales
+////////////////////////////////////////////////////////////////////////////////
+// Taille d'alphabet et longueur de mot mesurées pour chaque classe du profil.
+int alphabetSamples[SEARCH_ALPHABET_CLASSES] = {2, 4, 20, 70};
+int lengthSamples[SEARCH_LENGTH_CLASSES] = {4, 8, 16, 32, 64, MAX_WORD_LENGTH};
+
+// Nombre d'occurrences cumulé, pour que les recherches ne soient pas
+// éliminées par le compilateur.
+long long occurrenceCount = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+// Fonctions
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Fonction qui remplit une chaîne de caractères aléatoires sur un alphabet de
+ * taille donnée (mêmes lettres que singleStringText_generator).
+ *
+ * @param s chaîne à remplir.
+ * @param length longueur de la chaîne.
+ * @param alphabetSize taille de l'alphabet.
+ */
+void randomString(char* s, int length, int alphabetSize) {
+    for (int i = 0; i < length; i++) {
+        s[i] = (char) (rand() % alphabetSize + '!');
+    }
+    s[length] = '\0';
+}
+
+/**
+ * Fonction qui mesure le temps (en ms) d'un algorithme pour la recherche de
+ * nbWords mots dans un texte, chaque recherche étant répétée repeat fois.
+ * Renvoie -1 en cas d'erreur.
+ *
+ * @param algo algorithme à mesurer.
+ * @param text texte dans lequel rechercher les mots.
+ * @param textLength longueur du texte.
+ * @param words mots à rechercher (wordLength + 1 caractères chacun).
+ * @param nbWords nombre de mots.
+ * @param wordLength longueur des mots.
+ * @param repeat nombre de répétitions de chaque recherche.
+ * @return le temps total en ms, ou -1 en cas d'erreur.
+ */
+double timeAlgorithm(occurrenceSearch algo, char* text, ptrdiff_t textLength, char* words, int nbWords, int wordLength, int repeat) {
+    clock_t start = clock();
+    for (int r = 0; r < repeat; r++) {
+        for (int w = 0; w < nbWords; w++) {
+            long long count = algo(text, words + w * (wordLength + 1), textLength, wordLength, NULL, NULL);
+            // Test d'erreur. Si l'algorithme a échoué, on renvoie -1.
+            if (count < 0) {
+                return -1;
+            }
+            occurrenceCount += count;
+        }
+    }
+    clock_t end = clock();
+    return (double) (end - start) / CLOCKS_PER_SEC * 1000;
+}
+
+/**
+ * Fonction qui renvoie le numéro de l'algorithme le plus rapide (parmi ceux
+ * que search() peut appeler) pour la recherche des mots dans le texte.
+ * Renvoie -1 en cas d'erreur.
+ *
+ * @param text texte dans lequel rechercher les mots.
+ * @param textLength longueur du texte.
+ * @param words mots à rechercher (wordLength + 1 caractères chacun).
+ * @param nbWords nombre de mots.
+ * @param wordLength longueur des mots.
+ * @param repeat nombre de répétitions de chaque recherche.
+ * @return le numéro de l'algorithme le plus rapide, ou -1 en cas d'erreur.
+ */
+int fastestAlgorithm(char* text, int textLength, char* words, int nbWords, int wordLength, int repeat) {
+    int best = -1;
+    double bestTime = 0;
+    for (int algoNum = 1; algoNum <= MAX_ALGO_NUM; algoNum++) {
+        occurrenceSearch algo = searchAlgorithm(algoNum);
+        if (algo == NULL) {
+            continue;
+        }
+        double time = timeAlgorithm(algo, text, textLength, words, nbWords, wordLength, repeat);
+        // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+        if (time < 0) {
+            return -1;
+        }
+        if (best == -1 || time < bestTime) {
+            best = algoNum;
+            bestTime = time;
+        }
+    }
+    return best;
+}
+
+/**
+ * Fonction principale.
+ *
+ * @param argc nombre d'arguments.
+ * @param argv arguments.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int main(int argc, char** argv) {
+    // Test du nombre d'arguments.
+    if (argc > 2) {
+        printf("Usage : %s [profileFilename]\n", argv[0]);
+        return -1;
+    }
+    const char* filename = argc == 2 ? argv[1] : SEARCH_PROFILE_FILE;
+
+    // Allocation du texte (+ 1 pour la sentinelle des algorithmes naïfs) et
+    // des mots.
+    char* text = malloc(CALIBRATION_TEXT_LENGTH + 1);
+    char* words = malloc(CALIBRATION_WORDS * (MAX_WORD_LENGTH + 1));
+    // Test d'erreur. Si une allocation a échoué, on renvoie -1.
+    if (text == NULL || words == NULL) {
+        fprintf(stderr, "Erreur lors de l'allocation.\n");
+        free(text);
+        free(words);
+        return -1;
+    }
+
+    struct searchProfile profile = currentSearchProfile;
+
+    // Table de décision : meilleur algorithme pour chaque case.
+    printf("Alphabet \\ longueur :");
+    for (int l = 0; l < SEARCH_LENGTH_CLASSES; l++) {
+        printf(" %4d", lengthSamples[l]);
+    }
+    printf("\n");
+    for (int a = 0; a < SEARCH_ALPHABET_CLASSES; a++) {
+        randomString(text, CALIBRATION_TEXT_LENGTH, alphabetSamples[a]);
+        printf("%19d :", alphabetSamples[a]);
+        for (int l = 0; l < SEARCH_LENGTH_CLASSES; l++) {
+            int wordLength = lengthSamples[l];
+            for (int w = 0; w < CALIBRATION_WORDS; w++) {
+                randomString(words + w * (wordLength + 1), wordLength, alphabetSamples[a]);
+            }
+            int best = fastestAlgorithm(text, CALIBRATION_TEXT_LENGTH, words, CALIBRATION_WORDS, wordLength, 1);
+            // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+            if (best == -1) {
+                fprintf(stderr, "Erreur lors de la mesure des algorithmes.\n");
+                free(text);
+                free(words);
+                return -1;
+            }
+            profile.algo[a][l] = best;
+            printf(" %4d", best);
+            fflush(stdout);
+        }
+        printf("\n");
+    }
+
+    // Petits textes : on double la longueur du texte jusqu'à ce que
+    // l'algorithme naïf ne soit plus le plus rapide (alphabet de 4 lettres,
+    // mots de 8 lettres).
+    int wordLength = 8;
+    randomString(text, CALIBRATION_TEXT_LENGTH, 4);
+    for (int w = 0; w < CALIBRATION_WORDS; w++) {
+        randomString(words + w * (wordLength + 1), wordLength, 4);
+    }
+    profile.smallText = 0;
+    for (int textLength = 2 * wordLength; textLength <= 65536; textLength *= 2) {
+        double naifTime = timeAlgorithm(searchAlgorithm(1), text, textLength, words, CALIBRATION_WORDS, wordLength, SMALL_TEXT_REPEAT);
+        double bestTime = timeAlgorithm(searchAlgorithm(profile.algo[1][1]), text, textLength, words, CALIBRATION_WORDS, wordLength, SMALL_TEXT_REPEAT);
+        if (naifTime < 0 || bestTime < 0 || naifTime > bestTime) {
+            break;
+        }
+        profile.smallText = textLength + 1;
+    }
+    printf("Algorithme naïf en dessous de %d caractères.\n", profile.smallText);
+
+    // Écriture du profil.
+    free(text);
+    free(words);
+    if (saveSearchProfile(filename, &profile) == -1) {
+        fprintf(stderr, "Erreur lors de l'écriture du profil %s.\n", filename);
+        return -1;
+    }
+    printf("Profil écrit dans %s (%lld occurrences).\n", filename, occurrenceCount);
+    return 0;
+}
@@ -22,7 +22,14 @@
  * fichiers demo_text.txt et demo_wordList.txt.
  * 
  * Le programme affiche le temps d'exécution de chaque algorithme de recherche
- * exacte.
+ * exacte (le nombre de comparaisons de caractères de Boyer-Moore, Turbo-BM et
+ * Apostolico-Giancarlo est compté à part, par bmComparisons). Il compare enfin le débit de la recherche
+ * multi-motifs à celui de Horspool répété, selon la taille de la liste (la
+ * recherche multi-motifs n'est recommandée qu'à partir de 8 à 32 mots selon
+ * l'alphabet, voir searchWordList() dans search.h), et,
+ * pour un alphabet d'au plus 4 lettres, teste la recherche dans le texte
+ * compacté à 2 bits par caractère. Il mesure pour finir, pour chaque
+ * algorithme, la recherche avec fonction de rappel et le comptage seul.
  * 
  * AUTHEUR:
  * --------
@@ -34,6 +41,11 @@
 ////////////////////////////////////////////////////////////////////////////////
 #include "config.h"
 #include "exactSearchAlgos.h"
+#include "fmIndex.h"
+#include "mappedText.h"
+#include "packedSearch.h"
+#include "search.h"
+#include "suffixArray.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -44,6 +56,14 @@
 // DEFINES
 ////////////////////////////////////////////////////////////////////////////////
 
+////////////////////////////////////////////////////////////////////////////////
+// Variables globales
+////////////////////////////////////////////////////////////////////////////////
+// Nombre d'occurrences trouvées lors du dernier appel à measureTime (cumulé sur
+// tous les mots de la liste). Permet de vérifier que tous les algorithmes
+// trouvent les mêmes occurrences.
+long long occurrenceCount = 0;
+
 ////////////////////////////////////////////////////////////////////////////////
 // Fonctions
 ////////////////////////////////////////////////////////////////////////////////
@@ -94,219 +114,52 @@ int generateWordList(int wordListLength, int wordLength, int alphabetSize) {
     return 0;
 }
 
-/**
- * Fonction qui lit le texte dans le fichier demo_text.txt, et le stocke dans
- * la chaîne de caractères text.
- * Renvoie 0 en cas de succès, -1 sinon.
- * 
- * @param text chaîne de caractères dans laquelle stocker le texte.
- * @return 0 en cas de succès, -1 sinon.
- */
-int readText(char* text) {
-    // Ouverture du fichier.
-    FILE* file = fopen("demo_text.txt", "r");
-    // Test d'erreur. Si l'ouverture a échoué, on renvoie -1.
-    if (file == NULL) {
-        return -1;
-    }
-    // Lecture du texte avec fgets et test d'erreur.
-    if (fgets(text, MAX_TEXT_LENGTH, file) == NULL) {
-        return -1;
-    }
-    // Fermeture du fichier.
-    fclose(file);
-    // Succès, on renvoie 0.
-    return 0;
-}
-
 /**
  * Fonction qui cherche toutes les occurrences d'un mot dans un autre en
  * utilisant l'algorithme pris en paramètre.
- * L'algorithme pris en paramètre prend en paramètre le texte, le mot à chercher
- * et rend l'indice de la première occurrence du mot dans le texte.
- * Il faut donc appeler l'algorithme tant qu'il renvoie un indice différent de
- * -1.
+ * L'algorithme pris en paramètre est la variante "Occurrences" d'un
+ * algorithme de recherche exacte : il prend en paramètre le texte et le mot à
+ * chercher, et rend toutes les occurrences du mot dans le texte en une seule
+ * passe.
  * 
  * @param algo algorithme de recherche exacte à utiliser.
  * @param text texte dans lequel chercher le mot.
  * @param word mot à chercher dans le texte.
  * @param textLength longueur du texte.
  * @param wordLength longueur du mot.
- * @return 0 en cas de succès, -1 sinon.
+ * @return le nombre d'occurrences trouvées, -1 en cas d'erreur.
  */
-int runAlgo(int (*algo)(char*, char*, int, int), char* text, char* word, int textLength, int wordLength) {
-    // Initialisation de l'indice de la première occurrence.
-    int index = 0;
-    // Tant qu'on trouve une occurrence, on décale l'indice de la première
-    // occurrence
-    for (int i = 0; i < textLength - wordLength + 1; i++) {
-        // Appel de l'algorithme.
-        index = algo(text + i, word, textLength - i, wordLength);
-        // Test d'erreur. Si l'algorithme a échoué, on renvoie -1.
-        if (index == -2) {
-            return -1;
-        }
-        // Si l'algorithme a trouvé une occurrence, on décale l'indice de la
-        // première occurrence.
-        if (index != -1) {
-            i += index;
-        }
-        // Si aucune occurrence n'a été trouvée, on sort de la boucle.
-        else {
-            break;
-        }
-    }
-    // Succès, on renvoie 0.
-    return 0;
-}
-
-/**
- * Même fonction que runAlgo, mais pour l'algo MP morrisPratt(char* text,
- * char* word, int textLength, int wordLength, int* bonPref).
- * 
- * @param bonPref tableau de bon préfixe.
- * @param text texte dans lequel chercher le mot.
- * @param word mot à chercher dans le texte.
- * @param textLength longueur du texte.
- * @param wordLength longueur du mot.
- * @return 0 en cas de succès, -1 sinon.
- */
-int runAlgoMP(char* text, char* word, int textLength, int wordLength, int* bonPref) {
-    // Initialisation de l'indice de la première occurrence.
-    int index = 0;
-    // Tant qu'on trouve une occurrence, on décale l'indice de la première
-    // occurrence
-    for (int i = 0; i < textLength - wordLength + 1; i++) {
-        // Appel de l'algorithme.
-        index = morrisPratt(text + i, word, textLength - i, wordLength, bonPref);
-        // Test d'erreur. Si l'algorithme a échoué, on renvoie -1.
-        if (index == -2) {
-            return -1;
-        }
-        // Si l'algorithme a trouvé une occurrence, on décale l'indice de la
-        // première occurrence.
-        if (index != -1) {
-            i += index;
-        }
-        // Si aucune occurrence n'a été trouvée, on sort de la boucle.
-        else {
-            break;
-        }
-    }
-    // Succès, on renvoie 0.
-    return 0;
-}
-
-/**
- * Même fonction que runAlgo, mais pour l'algo KMP knuthMorrisPratt(char* text,
- * char* word, int textLength, int wordLength, int* meilPref).
- * 
- * @param meilPref tableau de meil préfixe.
- * @param text texte dans lequel chercher le mot.
- * @param word mot à chercher dans le texte.
- * @param textLength longueur du texte.
- * @param wordLength longueur du mot.
- * @return 0 en cas de succès, -1 sinon.
- */
-int runAlgoKMP(char* text, char* word, int textLength, int wordLength, int* meilPref) {
-    // Initialisation de l'indice de la première occurrence.
-    int index = 0;
-    // Tant qu'on trouve une occurrence, on décale l'indice de la première
-    // occurrence
-    for (int i = 0; i < textLength - wordLength + 1; i++) {
-        // Appel de l'algorithme.
-        index = knuthMorrisPratt(text + i, word, textLength - i, wordLength, meilPref);
-        // Test d'erreur. Si l'algorithme a échoué, on renvoie -1.
-        if (index == -2) {
-            return -1;
-        }
-        // Si l'algorithme a trouvé une occurrence, on décale l'indice de la
-        // première occurrence.
-        if (index != -1) {
-            i += index;
-        }
-        // Si aucune occurrence n'a été trouvée, on sort de la boucle.
-        else {
-            break;
-        }
-    }
-    // Succès, on renvoie 0.
-    return 0;
-}
-
-/**
- * Même fonction que runAlgo, mais pour l'algo BM boyerMoore(char* text,
- * int textLength, char* word, int wordLength, int* suff, int* bonSuff).
- * 
- * @param suff tableau de suffixe.
- * @param bonSuff tableau de bon suffixe.
- * @param text texte dans lequel chercher le mot.
- * @param word mot à chercher dans le texte.
- * @param textLength longueur du texte.
- * @param wordLength longueur du mot.
- * @return 0 en cas de succès, -1 sinon.
- */
-int runAlgoBM(char* text, char* word, int textLength, int wordLength, int* suff, int* bonSuff) {
-    // Initialisation de l'indice de la première occurrence.
-    int index = 0;
-    // Tant qu'on trouve une occurrence, on décale l'indice de la première
-    // occurrence
-    for (int i = 0; i < textLength - wordLength + 1; i++) {
-        // Appel de l'algo.
-        index = boyerMoore(text + i, textLength - i, word, wordLength, suff, bonSuff);
-        // Test d'erreur. Si l'algorithme a échoué, on renvoie -1.
-        if (index == -2) {
-            return -1;
-        }
-        // Si l'algorithme a trouvé une occurrence, on décale l'indice de la
-        // première occurrence.
-        if (index != -1) {
-            i += index;
-        }
-        // Si aucune occurrence n'a été trouvée, on sort de la boucle.
-        else {
-            break;
-        }
+long long runAlgo(long long (*algo)(char*, char*, ptrdiff_t, int, occurrenceCallback, void*), char* text, char* word, ptrdiff_t textLength, int wordLength) {
+    // Appel de l'algorithme, les occurrences sont seulement comptées.
+    long long count = algo(text, word, textLength, wordLength, NULL, NULL);
+    // Test d'erreur. Si l'algorithme a échoué, on renvoie -1.
+    if (count == -2) {
+        return -1;
     }
-    // Succès, on renvoie 0.
-    return 0;
+    // Succès, on renvoie le nombre d'occurrences.
+    return count;
 }
 
 /**
- * Même fonction que runAlgo, mais pour l'algo Horspool horspool(char* text,
- * int textLength, char* word, int wordLength, int* bonSuff).
+ * Même fonction que runAlgo, mais pour un algorithme à tables précalculées,
+ * appelé sur un motif compilé compiledOccurrences(struct compiledPattern*
+ * pattern, int algoNum, ...).
  * 
- * @param bonSuff tableau de bon suffixe.
+ * @param pattern motif compilé.
+ * @param algoNum numéro de l'algorithme (7, 8, 9, 10, 16 ou 17).
  * @param text texte dans lequel chercher le mot.
- * @param word mot à chercher dans le texte.
  * @param textLength longueur du texte.
- * @param wordLength longueur du mot.
- * @return 0 en cas de succès, -1 sinon.
+ * @return le nombre d'occurrences trouvées, -1 en cas d'erreur.
  */
-int runAlgoHorspool(char* text, char* word, int textLength, int wordLength, int* bonSuff) {
-    // Initialisation de l'indice de la première occurrence.
-    int index = 0;
-    // Tant qu'on trouve une occurrence, on décale l'indice de la première
-    // occurrence
-    for (int i = 0; i < textLength - wordLength + 1; i++) {
-        // Appel de l'algo.
-        index = horspool(text + i, textLength - i, word, wordLength, bonSuff);
-        // Test d'erreur. Si l'algorithme a échoué, on renvoie -1.
-        if (index == -2) {
-            return -1;
-        }
-        // Si l'algorithme a trouvé une occurrence, on décale l'indice de la
-        // première occurrence.
-        if (index != -1) {
-            i += index;
-        }
-        // Si aucune occurrence n'a été trouvée, on sort de la boucle.
-        else {
-            break;
-        }
+long long runAlgoCompiled(struct compiledPattern* pattern, int algoNum, char* text, ptrdiff_t textLength) {
+    // Appel de l'algorithme, les occurrences sont seulement comptées.
+    long long count = compiledOccurrences(pattern, algoNum, text, textLength, NULL, NULL);
+    // Test d'erreur. Si l'algorithme a échoué, on renvoie -1.
+    if (count == -2) {
+        return -1;
     }
-    // Succès, on renvoie 0.
-    return 0;
+    // Succès, on renvoie le nombre d'occurrences.
+    return count;
 }
 
 /**
@@ -345,17 +198,19 @@ double computeAverage(double* values, int length) {
  * @return temps moyen d'exécution de l'algorithme (en ms) en cas de succès,
  * -1 sinon.
  */
-double measureTime(int (*algo)(char*, char*, int, int), FILE* file, char* text, int textLength, int wordListLength, int wordLength) {
+double measureTime(long long (*algo)(char*, char*, ptrdiff_t, int, occurrenceCallback, void*), FILE* file, char* text, ptrdiff_t textLength, int wordListLength, int wordLength) {
     // Initialisations
-    int err = 0;
+    long long err = 0;
+    occurrenceCount = 0;
     // Tableau de temps d'exécution
     double times[wordListLength];
 
     // On lit chaque mot de la liste
     for (int i = 0; i < wordListLength; i++) {
         // On lit le mot
-        char word[wordLength + 1];
-        if (fgets(word, wordLength + 1, file) == NULL) {
+        // (wordLength + 2 pour lire aussi le retour à la ligne)
+        char word[wordLength + 2];
+        if (fgets(word, wordLength + 2, file) == NULL) {
             return -1;
         }
         // On mesure le temps d'exécution de l'algorithme
@@ -366,6 +221,8 @@ double measureTime(int (*algo)(char*, char*, int, int), FILE* file, char* text,
         if (err == -1) {
             return -1;
         }
+        // On compte les occurrences trouvées
+        occurrenceCount += err;
         // On stocke le temps d'exécution dans le tableau
         times[i] = (double) (end - start) / CLOCKS_PER_SEC * 1000;
     }
@@ -374,12 +231,12 @@ double measureTime(int (*algo)(char*, char*, int, int), FILE* file, char* text,
 }
 
 /**
- * Même fonction que measureTime, mais pour l'algo MP morrisPratt(char* text,
- * char* word, int textLength, int wordLength, int* bonPref).
- * On utilise ici donc la fonction bonPrefTable(char* word, int wordLength,
- * int* bonPref) pour calculer la table de bon préfixe à fournir en paramètre
- * à l'algorithme.
+ * Même fonction que measureTime, mais pour un algorithme à tables
+ * précalculées (MP, KMP, BM, Horspool, Turbo-BM, Apostolico-Giancarlo).
+ * Chaque mot est compilé une fois par compilePattern(), hors de la mesure,
+ * puis recherché avec compiledOccurrences().
  * 
+ * @param algoNum numéro de l'algorithme (7, 8, 9, 10, 16 ou 17).
  * @param file pointeur de fichier vers le fichier contenant la liste de mots.
  * @param text texte dans lequel chercher les mots de la liste.
  * @param textLength longueur du texte.
@@ -388,31 +245,37 @@ double measureTime(int (*algo)(char*, char*, int, int), FILE* file, char* text,
  * @return temps moyen d'exécution de l'algorithme (en ms) en cas de succès,
  * -1 sinon.
  */
-double measureTimeMP(FILE* file, char* text, int textLength, int wordListLength, int wordLength) {
+double measureTimeCompiled(int algoNum, FILE* file, char* text, ptrdiff_t textLength, int wordListLength, int wordLength) {
     // Initialisations
-    int err = 0;
+    long long err = 0;
+    occurrenceCount = 0;
     // Tableau de temps d'exécution
     double times[wordListLength];
-    // Tableau de bon préfixe
-    int bonPref[wordLength];
 
     // On lit chaque mot de la liste
     for (int i = 0; i < wordListLength; i++) {
         // On lit le mot
-        char word[wordLength + 1];
-        if (fgets(word, wordLength + 1, file) == NULL) {
+        // (wordLength + 2 pour lire aussi le retour à la ligne)
+        char word[wordLength + 2];
+        if (fgets(word, wordLength + 2, file) == NULL) {
+            return -1;
+        }
+        // On compile le mot (toutes ses tables)
+        struct compiledPattern* pattern = compilePattern(word, wordLength);
+        if (pattern == NULL) {
             return -1;
         }
-        // On calcule la table de bon préfixe
-        bonPrefTable(word, wordLength, bonPref);
         // On mesure le temps d'exécution de l'algorithme
         clock_t start = clock();
-        err = runAlgoMP(text, word, textLength, wordLength, bonPref);
+        err = runAlgoCompiled(pattern, algoNum, text, textLength);
         clock_t end = clock();
+        freePattern(pattern);
         // Test d'erreur
         if (err == -1) {
             return -1;
         }
+        // On compte les occurrences trouvées
+        occurrenceCount += err;
         // On stocke le temps d'exécution dans le tableau
         times[i] = (double) (end - start) / CLOCKS_PER_SEC * 1000;
     }
@@ -421,150 +284,461 @@ double measureTimeMP(FILE* file, char* text, int textLength, int wordListLength,
 }
 
 /**
- * Même fonction que measureTime, mais pour l'algo KMP knuthMorrisPratt(
- * char* text, char* word, int textLength, int wordLength, int* meilPref).
- * On utilise ici donc la fonction meilPrefTable(char* word, int wordLength,
- * int* meilPref) pour calculer la table de bon préfixe à fournir en paramètre
- * à l'algorithme.
+ * Fonction qui lit toute la liste de mots du fichier file. Les pointeurs et
+ * les mots sont rangés dans une seule allocation, à libérer par free().
+ * Renvoie la liste en cas de succès, NULL sinon.
+ * 
+ * @param file pointeur de fichier vers le fichier contenant la liste de mots.
+ * @param wordListLength longueur de la liste de mots.
+ * @param wordLength longueur des mots de la liste.
+ * @return la liste des mots en cas de succès, NULL sinon.
+ */
+char** readWordList(FILE* file, int wordListLength, int wordLength) {
+    // Allocation des pointeurs, suivis des mots
+    // (wordLength + 2 pour lire aussi le retour à la ligne).
+    char** words = malloc(sizeof(char*) * (size_t) wordListLength + (size_t) wordListLength * (size_t) (wordLength + 2));
+    // Test d'erreur. Si l'allocation a échoué, on renvoie NULL.
+    if (words == NULL) {
+        return NULL;
+    }
+    char* storage = (char*) (words + wordListLength);
+    // On lit chaque mot de la liste
+    for (int i = 0; i < wordListLength; i++) {
+        words[i] = storage + (size_t) i * (size_t) (wordLength + 2);
+        if (fgets(words[i], wordLength + 2, file) == NULL) {
+            free(words);
+            return NULL;
+        }
+    }
+    return words;
+}
+
+/**
+ * Même fonction que measureTime, mais pour la recherche multi-motifs
+ * multiKarpRabinOccurrences(char* text, ptrdiff_t textLength, char** words,
+ * int wordCount, int wordLength, ...).
+ * Toute la liste est recherchée en une seule passe sur le texte, même si elle
+ * compte moins de multiPatternMinWords() mots. Le temps renvoyé est le temps total divisé par wordListLength, pour être comparable
+ * au temps moyen par mot des autres algorithmes.
  * 
  * @param file pointeur de fichier vers le fichier contenant la liste de mots.
  * @param text texte dans lequel chercher les mots de la liste.
  * @param textLength longueur du texte.
  * @param wordListLength longueur de la liste de mots.
  * @param wordLength longueur des mots de la liste.
- * @return temps moyen d'exécution de l'algorithme (en ms) en cas de succès,
- * -1 sinon.
+ * @return temps moyen d'exécution par mot (en ms) en cas de succès, -1 sinon.
  */
-double measureTimeKMP(FILE* file, char* text, int textLength, int wordListLength, int wordLength) {
-    // Initialisations
-    int err = 0;
-    // Tableau de temps d'exécution
-    double times[wordListLength];
-    // Tableau de bon préfixe
-    int meilPref[wordLength];
+double measureTimeMulti(FILE* file, char* text, ptrdiff_t textLength, int wordListLength, int wordLength) {
+    // Lecture de toute la liste.
+    char** words = readWordList(file, wordListLength, wordLength);
+    if (words == NULL) {
+        return -1;
+    }
+    // On mesure le temps d'exécution de l'algorithme
+    clock_t start = clock();
+    long long count = multiKarpRabinOccurrences(text, textLength, words, wordListLength, wordLength, NULL, NULL);
+    clock_t end = clock();
+    free(words);
+    // Test d'erreur
+    if (count == -2) {
+        return -1;
+    }
+    // On compte les occurrences trouvées
+    occurrenceCount = count;
+    // On renvoie le temps par mot
+    return (double) (end - start) / CLOCKS_PER_SEC * 1000 / wordListLength;
+}
 
-    // On lit chaque mot de la liste
+/**
+ * Même fonction que measureTimeMulti, mais pour l'algo Wu-Manber
+ * wuManberOccurrences(char* text, ptrdiff_t textLength, char** words,
+ * int* wordLengths, int wordCount, ...).
+ * 
+ * @param file pointeur de fichier vers le fichier contenant la liste de mots.
+ * @param text texte dans lequel chercher les mots de la liste.
+ * @param textLength longueur du texte.
+ * @param wordListLength longueur de la liste de mots.
+ * @param wordLength longueur des mots de la liste.
+ * @return temps moyen d'exécution par mot (en ms) en cas de succès, -1 sinon.
+ */
+double measureTimeWuManber(FILE* file, char* text, ptrdiff_t textLength, int wordListLength, int wordLength) {
+    // Lecture de toute la liste.
+    char** words = readWordList(file, wordListLength, wordLength);
+    if (words == NULL) {
+        return -1;
+    }
+    // Tous les mots de la liste ont la même longueur.
+    int* wordLengths = malloc(sizeof(int) * (size_t) wordListLength);
+    if (wordLengths == NULL) {
+        free(words);
+        return -1;
+    }
     for (int i = 0; i < wordListLength; i++) {
-        // On lit le mot
-        char word[wordLength + 1];
-        if (fgets(word, wordLength + 1, file) == NULL) {
-            return -1;
-        }
-        // On calcule la table de bon préfixe
-        meilPrefTable(word, wordLength, meilPref);
-        // On mesure le temps d'exécution de l'algorithme
-        clock_t start = clock();
-        err = runAlgoKMP(text, word, textLength, wordLength, meilPref);
-        clock_t end = clock();
-        // Test d'erreur
-        if (err == -1) {
-            return -1;
-        }
-        // On stocke le temps d'exécution dans le tableau
-        times[i] = (double) (end - start) / CLOCKS_PER_SEC * 1000;
+        wordLengths[i] = wordLength;
     }
-    // On renvoie la moyenne des temps d'exécution
-    return computeAverage(times, wordListLength);
+    // On mesure le temps d'exécution de l'algorithme
+    clock_t start = clock();
+    long long count = wuManberOccurrences(text, textLength, words, wordLengths, wordListLength, NULL, NULL);
+    clock_t end = clock();
+    free(wordLengths);
+    free(words);
+    // Test d'erreur
+    if (count == -2) {
+        return -1;
+    }
+    // On compte les occurrences trouvées
+    occurrenceCount = count;
+    // On renvoie le temps par mot
+    return (double) (end - start) / CLOCKS_PER_SEC * 1000 / wordListLength;
 }
 
 /**
- * Même fonction que measureTime, mais pour l'algo BM boyerMoore(char* text,
- * int textLength, char* word, int wordLength, int* suff, int* bonSuff).
- * On utilise ici donc la fonction suffTable(char* word, int wordLength,
- * int* suff) et bonSuffTable(char* word, int wordLength, int* bonSuff) pour
- * calculer les tables de suffixe et de bon suffixe à fournir en paramètre
- * à l'algorithme.
+ * Même fonction que measureTime, mais pour l'index du texte (tableau des
+ * suffixes, voir suffixArray.h) : l'index est construit une fois, puis
+ * chaque mot de la liste est compté avec suffixArrayCount(). Le temps de
+ * construction est réparti sur les mots de la liste, pour comparer l'index
+ * aux algorithmes qui relisent le texte à chaque mot.
  * 
  * @param file pointeur de fichier vers le fichier contenant la liste de mots.
  * @param text texte dans lequel chercher les mots de la liste.
  * @param textLength longueur du texte.
  * @param wordListLength longueur de la liste de mots.
  * @param wordLength longueur des mots de la liste.
- * @return temps moyen d'exécution de l'algorithme (en ms) en cas de succès,
- * -1 sinon.
+ * @return temps moyen par mot, construction comprise (en ms) en cas de
+ * succès, -1 sinon.
  */
-double measureTimeBM(FILE* file, char* text, int textLength, int wordListLength, int wordLength) {
-    // Initialisations
-    int err = 0;
-    // Tableau de temps d'exécution
-    double times[wordListLength];
-    // Tableaux de suffixe et de bon suffixe
-    int suff[wordLength];
-    int bonSuff[wordLength];
+double measureTimeSuffixArray(FILE* file, char* text, ptrdiff_t textLength, int wordListLength, int wordLength) {
+    // Lecture de toute la liste.
+    char** words = readWordList(file, wordListLength, wordLength);
+    if (words == NULL) {
+        return -1;
+    }
+    // On mesure le temps de construction de l'index et des requêtes
+    occurrenceCount = 0;
+    clock_t start = clock();
+    struct suffixArray* index = buildSuffixArray(text, textLength);
+    if (index == NULL) {
+        free(words);
+        return -1;
+    }
+    for (int i = 0; i < wordListLength; i++) {
+        occurrenceCount += suffixArrayCount(index, words[i], wordLength);
+    }
+    clock_t end = clock();
+    freeSuffixArray(index);
+    free(words);
+    // On renvoie le temps par mot
+    return (double) (end - start) / CLOCKS_PER_SEC * 1000 / wordListLength;
+}
 
-    // On lit chaque mot de la liste
+/**
+ * Même fonction que measureTimeSuffixArray, mais pour l'index compressé du
+ * texte (index FM, voir fmIndex.h) : les mots sont comptés avec
+ * fmIndexCount().
+ * 
+ * @param file pointeur de fichier vers le fichier contenant la liste de mots.
+ * @param text texte dans lequel chercher les mots de la liste.
+ * @param textLength longueur du texte.
+ * @param wordListLength longueur de la liste de mots.
+ * @param wordLength longueur des mots de la liste.
+ * @return temps moyen par mot, construction comprise (en ms) en cas de
+ * succès, -1 sinon.
+ */
+double measureTimeFmIndex(FILE* file, char* text, ptrdiff_t textLength, int wordListLength, int wordLength) {
+    // Lecture de toute la liste.
+    char** words = readWordList(file, wordListLength, wordLength);
+    if (words == NULL) {
+        return -1;
+    }
+    // On mesure le temps de construction de l'index et des requêtes
+    occurrenceCount = 0;
+    clock_t start = clock();
+    struct fmIndex* index = buildFmIndex(text, textLength, FM_SAMPLE_RATE);
+    if (index == NULL) {
+        free(words);
+        return -1;
+    }
     for (int i = 0; i < wordListLength; i++) {
-        // On lit le mot
-        char word[wordLength + 1];
-        if (fgets(word, wordLength + 1, file) == NULL) {
-            return -1;
+        occurrenceCount += fmIndexCount(index, words[i], wordLength);
+    }
+    clock_t end = clock();
+    freeFmIndex(index);
+    free(words);
+    // On renvoie le temps par mot
+    return (double) (end - start) / CLOCKS_PER_SEC * 1000 / wordListLength;
+}
+
+/**
+ * Fonction qui compare, pour des listes de 1, 2, 4, ... mots (préfixes de la
+ * liste du fichier demo_wordList.txt), le débit de la recherche multi-motifs
+ * en une passe et celui de Horspool répété sur chaque mot, et indique le
+ * plus rapide. Le débit est la taille du texte divisée par le temps total de
+ * recherche de la liste (en Mo/s). La recherche multi-motifs n'est
+ * recommandée qu'à partir de multiPatternMinWords() mots (voir
+ * searchWordList() dans search.h).
+ * Renvoie 0 en cas de succès, -1 sinon.
+ * 
+ * @param text texte dans lequel rechercher les mots de la liste.
+ * @param textLength longueur du texte.
+ * @param wordListLength longueur de la liste de mots.
+ * @param wordLength longueur des mots de la liste.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int compareMultiPattern(char* text, ptrdiff_t textLength, int wordListLength, int wordLength) {
+    // Ouverture et lecture du fichier.
+    FILE* file = fopen("demo_wordList.txt", "r");
+    // Test d'erreur. Si l'ouverture a échoué, on renvoie -1.
+    if (file == NULL) {
+        return -1;
+    }
+    char** words = readWordList(file, wordListLength, wordLength);
+    fclose(file);
+    if (words == NULL) {
+        return -1;
+    }
+    int dernOcc[256];
+    int minWords = multiPatternMinWords(estimateAlphabetSize(text, textLength));
+
+    printf("\nMulti-motifs Karp-Rabin contre Horspool répété (débit en Mo/s, multi-motifs recommandé à partir de %d mots) :\n",
+           minWords);
+    for (int k = 1;; k *= 2) {
+        // La dernière liste est la liste entière.
+        if (k > wordListLength) {
+            k = wordListLength;
         }
-        // On calcule les tables de suffixe et de bon suffixe
-        suffTable(word, wordLength, suff);
-        bonSuffTable(word, wordLength, bonSuff);
-        // On mesure le temps d'exécution de l'algorithme
+        // Recherche des k premiers mots en une seule passe.
         clock_t start = clock();
-        err = runAlgoBM(text, word, textLength, wordLength, suff, bonSuff);
+        long long multiCount = multiKarpRabinOccurrences(text, textLength, words, k, wordLength, NULL, NULL);
         clock_t end = clock();
-        // Test d'erreur
-        if (err == -1) {
-            return -1;
+        double multiTime = (double) (end - start) / CLOCKS_PER_SEC;
+        // Recherche des k premiers mots, un par un.
+        long long horspoolCount = 0;
+        start = clock();
+        for (int i = 0; i < k; i++) {
+            dernOccTable(words[i], wordLength, dernOcc);
+            horspoolCount += horspoolOccurrences(text, textLength, words[i], wordLength, dernOcc, NULL, NULL);
+        }
+        end = clock();
+        double horspoolTime = (double) (end - start) / CLOCKS_PER_SEC;
+        // Affichage des débits.
+        printf("%6d mots : multi-motifs %10.1f, Horspool répété %10.1f (%lld / %lld occurrences), plus rapide : %s, recommandé : %s\n",
+               k, (double) textLength / multiTime / 1e6, (double) textLength / horspoolTime / 1e6, multiCount, horspoolCount,
+               multiTime < horspoolTime ? "multi-motifs" : "Horspool", k < minWords ? "mot par mot" : "multi-motifs");
+        if (k == wordListLength) {
+            break;
         }
-        // On stocke le temps d'exécution dans le tableau
-        times[i] = (double) (end - start) / CLOCKS_PER_SEC * 1000;
     }
-    // On renvoie la moyenne des temps d'exécution
-    return computeAverage(times, wordListLength);
+
+    free(words);
+    // Succès, on renvoie 0.
+    return 0;
 }
 
 /**
- * Même fonction que measureTime, mais pour l'algo Horspool horspool(char* text,
- * int textLength, char* word, int wordLength, int* bonSuff).
- * On utilise ici donc la fonction bonSuffTable(char* word, int wordLength,
- * int* bonSuff) pour calculer la table de bon suffixe à fournir en paramètre
- * à l'algorithme.
- * 
- * @param file pointeur de fichier vers le fichier contenant la liste de mots.
- * @param text texte dans lequel chercher les mots de la liste.
+ * Fonction qui teste la recherche dans le texte compacté à 2 bits par
+ * caractère (voir packedSearch.h), quand le texte a au plus 4 lettres.
+ * Le texte compacté est d'abord reconstruit et comparé au texte d'origine
+ * (aller-retour), puis chaque mot de la liste est recherché dans le texte
+ * compacté et dans le texte d'origine avec Horspool : les nombres
+ * d'occurrences doivent être égaux. On affiche le débit des deux recherches
+ * (en Mo/s).
+ * Renvoie 0 en cas de succès, -1 sinon.
+ *
+ * @param text texte dans lequel rechercher les mots de la liste.
  * @param textLength longueur du texte.
  * @param wordListLength longueur de la liste de mots.
  * @param wordLength longueur des mots de la liste.
- * @return temps moyen d'exécution de l'algorithme (en ms) en cas de succès,
- * -1 sinon.
+ * @return 0 en cas de succès, -1 sinon.
  */
-double measureTimeHorspool(FILE* file, char* text, int textLength, int wordListLength, int wordLength) {
-    // Initialisations
-    int err = 0;
-    // Tableau de temps d'exécution
-    double times[wordListLength];
-    // Tableau de bon suffixe
-    int bonSuff[wordLength];
+int testPackedSearch(char* text, ptrdiff_t textLength, int wordListLength, int wordLength) {
+    struct packedText packed;
+    if (packText(text, textLength, &packed) == -1) {
+        printf("\nRecherche compactée (2 bits) : texte de plus de 4 lettres, non testée.\n");
+        return 0;
+    }
 
-    // On lit chaque mot de la liste
-    for (int i = 0; i < wordListLength; i++) {
-        // On lit le mot
-        char word[wordLength + 1];
-        if (fgets(word, wordLength + 1, file) == NULL) {
+    // Aller-retour : le texte reconstruit doit être le texte d'origine.
+    char* unpacked = malloc((size_t) textLength);
+    // Test d'erreur. Si l'allocation a échoué, on renvoie -1.
+    if (unpacked == NULL) {
+        freePackedText(&packed);
+        return -1;
+    }
+    unpackText(&packed, unpacked);
+    for (ptrdiff_t i = 0; i < textLength; i++) {
+        if (unpacked[i] != text[i]) {
+            printf("Caractère %td : %c dans le texte reconstruit, %c attendu.\n", i, unpacked[i], text[i]);
+            free(unpacked);
+            freePackedText(&packed);
             return -1;
         }
-        // On calcule la table de bon suffixe
-        bonSuffTable(word, wordLength, bonSuff);
-        // On mesure le temps d'exécution de l'algorithme
+    }
+    free(unpacked);
+    printf("\nRecherche compactée (2 bits) : %td octets au lieu de %td, aller-retour correct.\n",
+           (textLength / PACKED_SYMBOLS + 2) * (ptrdiff_t) sizeof(uint64_t), textLength);
+
+    // Lecture de la liste de mots.
+    FILE* file = fopen("demo_wordList.txt", "r");
+    // Test d'erreur. Si l'ouverture a échoué, on renvoie -1.
+    if (file == NULL) {
+        freePackedText(&packed);
+        return -1;
+    }
+    char** words = readWordList(file, wordListLength, wordLength);
+    fclose(file);
+    if (words == NULL) {
+        freePackedText(&packed);
+        return -1;
+    }
+
+    // Recherche de chaque mot dans le texte compacté, puis avec Horspool.
+    int dernOcc[256];
+    long long packedCount = 0;
+    long long horspoolCount = 0;
+    double packedTime = 0;
+    double horspoolTime = 0;
+    for (int i = 0; i < wordListLength; i++) {
         clock_t start = clock();
-        err = runAlgoHorspool(text, word, textLength, wordLength, bonSuff);
+        long long count = packedOccurrences(&packed, words[i], wordLength, NULL, NULL);
         clock_t end = clock();
-        // Test d'erreur
-        if (err == -1) {
+        packedTime += (double) (end - start) / CLOCKS_PER_SEC;
+        packedCount += count;
+        start = clock();
+        dernOccTable(words[i], wordLength, dernOcc);
+        long long expected = horspoolOccurrences(text, textLength, words[i], wordLength, dernOcc, NULL, NULL);
+        end = clock();
+        horspoolTime += (double) (end - start) / CLOCKS_PER_SEC;
+        horspoolCount += expected;
+        if (count != expected) {
+            printf("Mot %s : %lld occurrences dans le texte compacté, %lld attendues.\n", words[i], count, expected);
+            free(words);
+            freePackedText(&packed);
             return -1;
         }
-        // On stocke le temps d'exécution dans le tableau
-        times[i] = (double) (end - start) / CLOCKS_PER_SEC * 1000;
     }
-    // On renvoie la moyenne des temps d'exécution
-    return computeAverage(times, wordListLength);
+    printf("Débit : compacté %10.1f, Horspool %10.1f (%lld / %lld occurrences)\n",
+           (double) textLength * wordListLength / packedTime / 1e6, (double) textLength * wordListLength / horspoolTime / 1e6, packedCount, horspoolCount);
+
+    free(words);
+    freePackedText(&packed);
+    // Succès, on renvoie 0.
+    return 0;
 }
 
 
+/**
+ * Fonction de rappel qui compte les occurrences dans un long long (consommateur
+ * minimal des versions "Occurrences", pour compareCountReport).
+ *
+ * @param index indice de l'occurrence (non utilisé).
+ * @param data pointeur vers le compteur.
+ * @return 0 (la recherche continue).
+ */
+int countOccurrence(ptrdiff_t index, void* data) {
+    (void) index;
+    *(long long*) data += 1;
+    return 0;
+}
+
+/**
+ * Fonction qui compare, pour chaque algorithme, la version "Occurrences", qui
+ * appelle une fonction de rappel pour chaque occurrence, et la version
+ * "Count", qui compte seulement les occurrences (voir exactSearchAlgos.h).
+ * Chaque mot de la liste est recherché avec les deux versions, qui doivent
+ * trouver autant d'occurrences ; les algorithmes à tables précalculées
+ * utilisent un motif compilé. On affiche le temps total des deux versions
+ * (en ms) et le temps de comptage rapporté au temps avec rappel : la plupart
+ * des versions "Count" appellent la version "Occurrences", ce rapport reste
+ * donc proche de 1 et ses écarts sont ceux de la mesure.
+ * Renvoie 0 en cas de succès, -1 sinon.
+ *
+ * @param text texte dans lequel rechercher les mots de la liste.
+ * @param textLength longueur du texte.
+ * @param wordListLength longueur de la liste de mots.
+ * @param wordLength longueur des mots de la liste.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int compareCountReport(char* text, ptrdiff_t textLength, int wordListLength, int wordLength) {
+    // Algorithmes sans table précalculée, puis numéros des algorithmes à
+    // tables précalculées (compiledOccurrences).
+    const char* names[] = {"Naïf", "Naïf, boucle rapide", "Naïf, sentinelle", "Naïf strncmp", "Naïf strncmp, boucle rapide",
+                           "Naïf strncmp, sentinelle", "Naïf vectorisé", "Two-Way", "Shift-Or", "BNDM", "BOM", "Karp-Rabin",
+                           "Quick Search", "Raita", "Horspool optimisé", "Morris-Pratt", "Knuth-Morris-Pratt", "Boyer-Moore",
+                           "Horspool", "Turbo-BM", "Apostolico-Giancarlo"};
+    occurrenceSearch reportAlgos[] = {&naifOccurrences, &naifBoucleRapideOccurrences, &naifSentinelleOccurrences,
+                                      &naifStrncmpOccurrences, &naifRapideStrncmpOccurrences, &naifSentinelleStrncmpOccurrences,
+                                      &naifSimdOccurrences, &twoWayOccurrences, &shiftOrOccurrences, &bndmOccurrences,
+                                      &bomOccurrences, &karpRabinOccurrences, &quickSearchOccurrences, &raitaOccurrences,
+                                      &horspoolOptimiseOccurrences};
+    countSearch countAlgos[] = {&naifCount, &naifBoucleRapideCount, &naifSentinelleCount, &naifStrncmpCount,
+                                &naifRapideStrncmpCount, &naifSentinelleStrncmpCount, &naifSimdCount, &twoWayCount,
+                                &shiftOrCount, &bndmCount, &bomCount, &karpRabinCount, &quickSearchCount, &raitaCount,
+                                &horspoolOptimiseCount};
+    int compiledAlgos[] = {7, 8, 9, 10, 16, 17};
+    int nbAlgos = (int) (sizeof(reportAlgos) / sizeof(reportAlgos[0]));
+    int nbCompiled = (int) (sizeof(compiledAlgos) / sizeof(compiledAlgos[0]));
+
+    // Lecture de la liste de mots et compilation des motifs.
+    FILE* file = fopen("demo_wordList.txt", "r");
+    // Test d'erreur. Si l'ouverture a échoué, on renvoie -1.
+    if (file == NULL) {
+        return -1;
+    }
+    char** words = readWordList(file, wordListLength, wordLength);
+    fclose(file);
+    if (words == NULL) {
+        return -1;
+    }
+    struct compiledPattern* patterns[wordListLength];
+    int compiled = 0;
+    for (; compiled < wordListLength; compiled++) {
+        patterns[compiled] = compilePattern(words[compiled], wordLength);
+        if (patterns[compiled] == NULL) {
+            break;
+        }
+    }
+    int err = compiled == wordListLength ? 0 : -1;
+
+    printf("\nRecherche avec fonction de rappel contre comptage seul (temps total) :\n");
+    for (int a = 0; err == 0 && a < nbAlgos + nbCompiled; a++) {
+        long long reportCount = 0;
+        long long countCount = 0;
+        long long count = 0;
+        // Version "Occurrences", avec une fonction de rappel.
+        clock_t start = clock();
+        for (int i = 0; i < wordListLength && count >= 0; i++) {
+            count = a < nbAlgos ? reportAlgos[a](text, words[i], textLength, wordLength, &countOccurrence, &reportCount)
+                                : compiledOccurrences(patterns[i], compiledAlgos[a - nbAlgos], text, textLength, &countOccurrence, &reportCount);
+        }
+        clock_t end = clock();
+        double reportTime = (double) (end - start) / CLOCKS_PER_SEC * 1000;
+        // Version "Count".
+        start = clock();
+        for (int i = 0; i < wordListLength && count >= 0; i++) {
+            count = a < nbAlgos ? countAlgos[a](text, words[i], textLength, wordLength)
+                                : compiledCount(patterns[i], compiledAlgos[a - nbAlgos], text, textLength);
+            countCount += count;
+        }
+        end = clock();
+        double countTime = (double) (end - start) / CLOCKS_PER_SEC * 1000;
+        // Test d'erreur. Si une recherche a échoué ou si les versions ne
+        // trouvent pas autant d'occurrences, on renvoie -1.
+        if (count < 0 || reportCount != countCount) {
+            printf("%s : %lld occurrences avec rappel, %lld en comptage seul.\n", names[a], reportCount, countCount);
+            err = -1;
+            break;
+        }
+        printf("%s : rappel %f (ms), comptage %f (ms), comptage / rappel %.2f (%lld occurrences)\n",
+               names[a], reportTime, countTime, reportTime > 0 ? countTime / reportTime : 0, countCount);
+    }
+
+    for (int i = 0; i < compiled; i++) {
+        freePattern(patterns[i]);
+    }
+    free(words);
+    return err;
+}
+
 /**
  * Fonction qui lit la liste de mots dans le fichier demo_wordList.txt, et
  * mesure le temps moyen d'exécution de chaque algorithme de recherche exacte.
@@ -578,7 +752,7 @@ double measureTimeHorspool(FILE* file, char* text, int textLength, int wordListL
  * @param wordLength longueur des mots de la liste.
  * @return 0 en cas de succès, -1 sinon.
  */
-int testAlgos(char* text, int textLength, int wordListLength, int wordLength) {
+int testAlgos(char* text, ptrdiff_t textLength, int wordListLength, int wordLength) {
     // Ouverture du fichier.
     FILE* file = fopen("demo_wordList.txt", "r");
     // Test d'erreur. Si l'ouverture a échoué, on renvoie -1.
@@ -590,121 +764,313 @@ int testAlgos(char* text, int textLength, int wordListLength, int wordLength) {
 
     // Mesure du temps d'exécution de l'algorithme naïf, sans boucle rapide, sans sentinelle.
     printf("Algo naïf, sans boucle rapide, sans sentinelle : ");
-    err = measureTime(&naif, file, text, textLength, wordListLength, wordLength);
+    err = measureTime(&naifOccurrences, file, text, textLength, wordListLength, wordLength);
     // Test d'erreur. Si la mesure a échoué, on renvoie -1.
     if (err == -1) {
         return -1;
     }
     // Affichage du temps d'exécution.
-    printf("%f (ms)\n", err);
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
     // On revient au début du fichier.
     rewind(file);
 
     // Mesure du temps d'exécution de l'algorithme naïf, avec boucle rapide, sans sentinelle.
     printf("Algo naïf, avec boucle rapide, sans sentinelle : ");
-    err = measureTime(&naifBoucleRapide, file, text, textLength, wordListLength, wordLength);
+    err = measureTime(&naifBoucleRapideOccurrences, file, text, textLength, wordListLength, wordLength);
     // Test d'erreur. Si la mesure a échoué, on renvoie -1.
     if (err == -1) {
         return -1;
     }
     // Affichage du temps d'exécution.
-    printf("%f (ms)\n", err);
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
     // On revient au début du fichier.
     rewind(file);
 
     // Mesure du temps d'exécution de l'algorithme naïf, avec boucle rapide, avec sentinelle.
     printf("Algo naïf, avec boucle rapide, avec sentinelle : ");
-    err = measureTime(&naifSentinelle, file, text, textLength, wordListLength, wordLength);
+    err = measureTime(&naifSentinelleOccurrences, file, text, textLength, wordListLength, wordLength);
     // Test d'erreur. Si la mesure a échoué, on renvoie -1.
     if (err == -1) {
         return -1;
     }
     // Affichage du temps d'exécution.
-    printf("%f (ms)\n", err);
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
     // On revient au début du fichier.
     rewind(file);
 
     // Mesure du temps d'exécution de l'algorithme naïf avec strncmp, sans boucle rapide, sans sentinelle.
     printf("Algo naïf avec strncmp, sans boucle rapide, sans sentinelle : ");
-    err = measureTime(&naifStrncmp, file, text, textLength, wordListLength, wordLength);
+    err = measureTime(&naifStrncmpOccurrences, file, text, textLength, wordListLength, wordLength);
     // Test d'erreur. Si la mesure a échoué, on renvoie -1.
     if (err == -1) {
         return -1;
     }
     // Affichage du temps d'exécution.
-    printf("%f (ms)\n", err);
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
     // On revient au début du fichier.
     rewind(file);
 
     // Mesure du temps d'exécution de l'algorithme naïf avec strncmp, avec boucle rapide, sans sentinelle.
     printf("Algo naïf avec strncmp, avec boucle rapide, sans sentinelle : ");
-    err = measureTime(&naifRapideStrncmp, file, text, textLength, wordListLength, wordLength);
+    err = measureTime(&naifRapideStrncmpOccurrences, file, text, textLength, wordListLength, wordLength);
     // Test d'erreur. Si la mesure a échoué, on renvoie -1.
     if (err == -1) {
         return -1;
     }
     // Affichage du temps d'exécution.
-    printf("%f (ms)\n", err);
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
     // On revient au début du fichier.
     rewind(file);
 
     // Mesure du temps d'exécution de l'algorithme naïf avec strncmp, avec boucle rapide, avec sentinelle.
     printf("Algo naïf avec strncmp, avec boucle rapide, avec sentinelle : ");
-    err = measureTime(&naifSentinelleStrncmp, file, text, textLength, wordListLength, wordLength);
+    err = measureTime(&naifSentinelleStrncmpOccurrences, file, text, textLength, wordListLength, wordLength);
+    // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+    if (err == -1) {
+        return -1;
+    }
+    // Affichage du temps d'exécution.
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
+    // On revient au début du fichier.
+    rewind(file);
+
+    // Mesure du temps d'exécution de l'algorithme naïf vectorisé.
+    printf("Algo naïf vectorisé (SSE2/AVX2) : ");
+    err = measureTime(&naifSimdOccurrences, file, text, textLength, wordListLength, wordLength);
     // Test d'erreur. Si la mesure a échoué, on renvoie -1.
     if (err == -1) {
         return -1;
     }
     // Affichage du temps d'exécution.
-    printf("%f (ms)\n", err);
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
     // On revient au début du fichier.
     rewind(file);
 
     // Mesure du temps d'exécution de l'algorithme Morris-Pratt.
     printf("Algo Morris-Pratt : ");
-    err = measureTimeMP(file, text, textLength, wordListLength, wordLength);
+    err = measureTimeCompiled(7, file, text, textLength, wordListLength, wordLength);
     // Test d'erreur. Si la mesure a échoué, on renvoie -1.
     if (err == -1) {
         return -1;
     }
     // Affichage du temps d'exécution.
-    printf("%f (ms)\n", err);
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
     // On revient au début du fichier.
     rewind(file);
 
     // Mesure du temps d'exécution de l'algorithme Knuth-Morris-Pratt.
     printf("Algo Knuth-Morris-Pratt : ");
-    err = measureTimeKMP(file, text, textLength, wordListLength, wordLength);
+    err = measureTimeCompiled(8, file, text, textLength, wordListLength, wordLength);
     // Test d'erreur. Si la mesure a échoué, on renvoie -1.
     if (err == -1) {
         return -1;
     }
     // Affichage du temps d'exécution.
-    printf("%f (ms)\n", err);
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
     // On revient au début du fichier.
     rewind(file);
 
     // Mesure du temps d'exécution de l'algorithme Boyer-Moore.
     printf("Algo Boyer-Moore : ");
-    err = measureTimeBM(file, text, textLength, wordListLength, wordLength);
+    err = measureTimeCompiled(9, file, text, textLength, wordListLength, wordLength);
     // Test d'erreur. Si la mesure a échoué, on renvoie -1.
     if (err == -1) {
         return -1;
     }
     // Affichage du temps d'exécution.
-    printf("%f (ms)\n", err);
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
     // On revient au début du fichier.
     rewind(file);
 
     // Mesure du temps d'exécution de l'algorithme Horspool.
     printf("Algo Horspool : ");
-    err = measureTimeHorspool(file, text, textLength, wordListLength, wordLength);
+    err = measureTimeCompiled(10, file, text, textLength, wordListLength, wordLength);
+    // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+    if (err == -1) {
+        return -1;
+    }
+    // Affichage du temps d'exécution.
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
+    // On revient au début du fichier.
+    rewind(file);
+
+    // Mesure du temps d'exécution de l'algorithme Two-Way.
+    printf("Algo Two-Way : ");
+    err = measureTime(&twoWayOccurrences, file, text, textLength, wordListLength, wordLength);
+    // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+    if (err == -1) {
+        return -1;
+    }
+    // Affichage du temps d'exécution.
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
+    // On revient au début du fichier.
+    rewind(file);
+
+    // Mesure du temps d'exécution de l'algorithme Shift-Or.
+    printf("Algo Shift-Or : ");
+    err = measureTime(&shiftOrOccurrences, file, text, textLength, wordListLength, wordLength);
+    // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+    if (err == -1) {
+        return -1;
+    }
+    // Affichage du temps d'exécution.
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
+    // On revient au début du fichier.
+    rewind(file);
+
+    // Mesure du temps d'exécution de l'algorithme BNDM.
+    printf("Algo BNDM : ");
+    err = measureTime(&bndmOccurrences, file, text, textLength, wordListLength, wordLength);
+    // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+    if (err == -1) {
+        return -1;
+    }
+    // Affichage du temps d'exécution.
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
+    // On revient au début du fichier.
+    rewind(file);
+
+    // Mesure du temps d'exécution de l'algorithme BOM.
+    printf("Algo BOM : ");
+    err = measureTime(&bomOccurrences, file, text, textLength, wordListLength, wordLength);
     // Test d'erreur. Si la mesure a échoué, on renvoie -1.
     if (err == -1) {
         return -1;
     }
     // Affichage du temps d'exécution.
-    printf("%f (ms)\n", err);
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
+    // On revient au début du fichier.
+    rewind(file);
+
+    // Mesure du temps d'exécution de l'algorithme Turbo-BM.
+    printf("Algo Turbo-BM : ");
+    err = measureTimeCompiled(16, file, text, textLength, wordListLength, wordLength);
+    // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+    if (err == -1) {
+        return -1;
+    }
+    // Affichage du temps d'exécution.
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
+    // On revient au début du fichier.
+    rewind(file);
+
+    // Mesure du temps d'exécution de l'algorithme Apostolico-Giancarlo.
+    printf("Algo Apostolico-Giancarlo : ");
+    err = measureTimeCompiled(17, file, text, textLength, wordListLength, wordLength);
+    // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+    if (err == -1) {
+        return -1;
+    }
+    // Affichage du temps d'exécution.
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
+    // On revient au début du fichier.
+    rewind(file);
+
+    // Mesure du temps d'exécution de l'algorithme Karp-Rabin.
+    printf("Algo Karp-Rabin : ");
+    err = measureTime(&karpRabinOccurrences, file, text, textLength, wordListLength, wordLength);
+    // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+    if (err == -1) {
+        return -1;
+    }
+    // Affichage du temps d'exécution.
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
+    // On revient au début du fichier.
+    rewind(file);
+
+    // Mesure du temps d'exécution de l'algorithme multi-motifs (Karp-Rabin).
+    printf("Algo multi-motifs Karp-Rabin (temps par mot) : ");
+    err = measureTimeMulti(file, text, textLength, wordListLength, wordLength);
+    // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+    if (err == -1) {
+        return -1;
+    }
+    // Affichage du temps d'exécution.
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
+    // On revient au début du fichier.
+    rewind(file);
+
+    // Mesure du temps d'exécution de l'algorithme Wu-Manber.
+    printf("Algo Wu-Manber (temps par mot) : ");
+    err = measureTimeWuManber(file, text, textLength, wordListLength, wordLength);
+    // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+    if (err == -1) {
+        return -1;
+    }
+    // Affichage du temps d'exécution.
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
+    // On revient au début du fichier.
+    rewind(file);
+
+    // Mesure du temps d'exécution de l'algorithme Quick Search.
+    printf("Algo Quick Search : ");
+    err = measureTime(&quickSearchOccurrences, file, text, textLength, wordListLength, wordLength);
+    // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+    if (err == -1) {
+        return -1;
+    }
+    // Affichage du temps d'exécution.
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
+    // On revient au début du fichier.
+    rewind(file);
+
+    // Mesure du temps d'exécution de l'algorithme Raita.
+    printf("Algo Raita : ");
+    err = measureTime(&raitaOccurrences, file, text, textLength, wordListLength, wordLength);
+    // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+    if (err == -1) {
+        return -1;
+    }
+    // Affichage du temps d'exécution.
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
+    // On revient au début du fichier.
+    rewind(file);
+
+    // Mesure du temps d'exécution de l'algorithme Horspool optimisé.
+    printf("Algo Horspool optimisé : ");
+    err = measureTime(&horspoolOptimiseOccurrences, file, text, textLength, wordListLength, wordLength);
+    // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+    if (err == -1) {
+        return -1;
+    }
+    // Affichage du temps d'exécution.
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
+    // On revient au début du fichier.
+    rewind(file);
+
+    // Mesure du temps d'exécution de l'algorithme search (choix automatique).
+    printf("Algo search (choix automatique) : ");
+    err = measureTime(&search, file, text, textLength, wordListLength, wordLength);
+    // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+    if (err == -1) {
+        return -1;
+    }
+    // Affichage du temps d'exécution.
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
+    // On revient au début du fichier.
+    rewind(file);
+
+    // Mesure du temps de l'index (tableau des suffixes), construction comprise.
+    printf("Tableau des suffixes (temps par mot, construction comprise) : ");
+    err = measureTimeSuffixArray(file, text, textLength, wordListLength, wordLength);
+    // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+    if (err == -1) {
+        return -1;
+    }
+    // Affichage du temps d'exécution.
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
+    // On revient au début du fichier.
+    rewind(file);
+
+    // Mesure du temps de l'index FM, construction comprise.
+    printf("Index FM (temps par mot, construction comprise) : ");
+    err = measureTimeFmIndex(file, text, textLength, wordListLength, wordLength);
+    // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+    if (err == -1) {
+        return -1;
+    }
+    // Affichage du temps d'exécution.
+    printf("%f (ms), %lld occurrences\n", err, occurrenceCount);
     // On revient au début du fichier.
     rewind(file);
 
@@ -752,6 +1118,10 @@ int main(int argc, char** argv) {
         return -1;
     }
 
+    // Chargement du profil de search(), s'il a été calibré (sinon, profil
+    // par défaut).
+    loadSearchProfile(SEARCH_PROFILE_FILE);
+
     // Génération du texte et de la liste de mots.
     if (generateText(textLength, alphabetSize) == -1) {
         fprintf(stderr, "Erreur lors de la génération du texte.\n");
@@ -761,17 +1131,40 @@ int main(int argc, char** argv) {
         fprintf(stderr, "Erreur lors de la génération de la liste de mots.\n");
         return -1;
     }
-    // Lecture du texte.
-    char text[MAX_TEXT_LENGTH];
-    if (readText(text) == -1) {
+    // Projection du texte en mémoire, modifiable et suivie d'un octet pour la
+    // sentinelle des algorithmes 3 et 6.
+    struct mappedText mapped;
+    if (mapText("demo_text.txt", 1, MAPPED_TEXT_WRITABLE | MAPPED_TEXT_HUGE_PAGES, &mapped) == -1) {
         fprintf(stderr, "Erreur lors de la lecture du texte.\n");
         return -1;
     }
+    char* text = mapped.text;
+    ptrdiff_t mappedLength = (ptrdiff_t) mapped.length;
     // Test des algorithmes.
-    if (testAlgos(text, textLength, wordListLength, wordLength) == -1) {
+    if (testAlgos(text, mappedLength, wordListLength, wordLength) == -1) {
         fprintf(stderr, "Erreur lors du test des algorithmes.\n");
+        unmapText(&mapped);
+        return -1;
+    }
+    // Comparaison multi-motifs / Horspool répété selon la taille de la liste.
+    if (compareMultiPattern(text, mappedLength, wordListLength, wordLength) == -1) {
+        fprintf(stderr, "Erreur lors de la comparaison multi-motifs.\n");
+        unmapText(&mapped);
+        return -1;
+    }
+    // Recherche dans le texte compacté à 2 bits par caractère.
+    if (testPackedSearch(text, mappedLength, wordListLength, wordLength) == -1) {
+        fprintf(stderr, "Erreur lors du test de la recherche compactée.\n");
+        unmapText(&mapped);
+        return -1;
+    }
+    // Version "Occurrences" (fonction de rappel) contre version "Count".
+    if (compareCountReport(text, mappedLength, wordListLength, wordLength) == -1) {
+        fprintf(stderr, "Erreur lors de la comparaison des versions de comptage.\n");
+        unmapText(&mapped);
         return -1;
     }
+    unmapText(&mapped);
     // Succès, on renvoie 0.
     return 0;
 }
\ No newline at end of file
@@ -10,22 +10,105 @@
  * ALGORITHMES:
  * ------------
  * 1. Naif, avec boucle interne, sans boucle rapide, sans sentinelle.
+ * 2. Naif, avec boucle rapide, sans sentinelle.
+ * 3. Naif, avec boucle rapide, avec sentinelle.
+ * 4. à 6. Les mêmes, avec strncmp().
+ * 7. Morris-Pratt.
+ * 8. Knuth-Morris-Pratt.
+ * 9. Boyer-Moore.
+ * 10. Horspool.
+ * 11. Naif vectorisé (SSE2/AVX2).
+ * 12. Two-Way (Crochemore-Perrin).
+ * 13. Shift-Or (état de 64 bits, plusieurs mots au-delà de 64).
+ * 14. BNDM (automate des suffixes simulé par bits).
+ * 15. BOM (oracle des facteurs).
+ * 16. Turbo-BM.
+ * 17. Apostolico-Giancarlo.
+ * 18. Karp-Rabin (hachage glissant modulo 2^32).
+ * 19. Karp-Rabin multi-motifs (une passe pour toute la liste).
+ * 20. Wu-Manber (multi-motifs de longueurs quelconques).
+ * 21. Quick Search (Sunday).
+ * 22. Raita.
+ * 23. Horspool optimisé (boucle de saut déroulée, sentinelle dans la table).
+ * 24. search() : choix automatique de l'algorithme (voir search.h).
+ * 25. Index du texte : tableau des suffixes et LCP (voir suffixArray.h).
+ * 26. Index compressé du texte : index FM (voir fmIndex.h).
+ * 
+ * Les algorithmes 1 à 10 existent en deux versions : l'une renvoie la première
+ * occurrence, l'autre (suffixe "Occurrences") rend toutes les occurrences en
+ * une seule passe sur le texte. Les suivants n'existent qu'en version
+ * "Occurrences". Chaque version "Occurrences" a une version "Count" qui
+ * compte seulement les occurrences, sans fonction de rappel.
+ * 
+ * Les longueurs et les positions dans le texte sont des ptrdiff_t (textes de
+ * plus de 2 Go) et les nombres d'occurrences des long long. Les mots restent
+ * courts : leurs longueurs, les états des automates et les tables de
+ * prétraitement restent des int.
  * 
  * AUTEUR:
  * -------
  * M. TAIA
  */
 
+#ifndef EXACT_SEARCH_ALGOS_H
+#define EXACT_SEARCH_ALGOS_H
+
 ////////////////////////////////////////////////////////////////////////////////
 // INCLUDES
 ////////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// Les noyaux vectorisés reposent sur l'attribut target et
+// __builtin_cpu_supports(), les versions "Count" sur l'attribut flatten :
+// GCC ou Clang seulement.
+#ifndef __GNUC__
+#error "exactSearchAlgos.h doit être compilé avec GCC ou Clang."
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 // DEFINES
 ////////////////////////////////////////////////////////////////////////////////
+// Comparaison de deux caractères du mot et du texte dans les algorithmes de la
+// famille Boyer-Moore. Si COUNT_COMPARISONS est défini avant l'inclusion de ce
+// fichier, chaque comparaison incrémente comparisonCount.
+#ifdef COUNT_COMPARISONS
+long comparisonCount = 0;
+#define COMPARE(a, b) (comparisonCount++, (a) == (b))
+#else
+#define COMPARE(a, b) ((a) == (b))
+#endif
+
+// Base du hachage polynomial de Karp-Rabin. Les calculs se font modulo 2^32
+// (débordement naturel des entiers non signés de 32 bits).
+#define KARP_RABIN_BASE 257u
+
+// Nombre de fenêtres d'un bloc de Karp-Rabin, et nombre de fenêtres dont les
+// hachages sont calculés à partir du même hachage précédent (voir
+// karpRabinOccurrences()).
+#define KARP_RABIN_BLOCK 8
+#define KARP_RABIN_STEP 4
+
+// Taille des tables de Wu-Manber indexées par la valeur d'un bloc de 1 à 3
+// caractères.
+#define WU_MANBER_TABLE_SIZE 65536
+
+// Nombre de mots à partir duquel multiKarpRabinOccurrences() est plus rapide
+// que Horspool répété sur chaque mot (comparaison de demo, texte de 10^6
+// caractères) : 8 mots pour un alphabet d'au plus 4 lettres, 32 au-delà.
+#define MULTI_KARP_RABIN_MIN_WORDS 32
+#define MULTI_KARP_RABIN_MIN_WORDS_SMALL_ALPHABET 8
+
+// Alignement (taille d'une ligne de cache) de l'allocation d'un motif
+// compilé.
+#define PATTERN_ALIGNMENT 64
 
 ////////////////////////////////////////////////////////////////////////////////
 // Fonctions
@@ -43,7 +126,7 @@
  * @return l'indice du premier caractère du mot dans le texte, si le mot est
  *        trouvé, -1 sinon, ou -2 en cas d'erreur.
 */
-int naif(char* text, char* word, int textLength, int wordLength) {
+ptrdiff_t naif(char* text, char* word, ptrdiff_t textLength, int wordLength) {
     // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
     if (text == NULL || word == NULL) {
         return -2;
@@ -55,7 +138,7 @@ int naif(char* text, char* word, int textLength, int wordLength) {
     }
 
     // Recherche du mot dans le texte.
-    for (int i = 0; i < textLength - wordLength + 1; i++) {
+    for (ptrdiff_t i = 0; i < textLength - wordLength + 1; i++) {
         // Boucle interne.
         for (int j = 0; j < wordLength; j++) {
             // Si le caractère du texte est différent du caractère du mot, on
@@ -88,7 +171,7 @@ int naif(char* text, char* word, int textLength, int wordLength) {
  * @return l'indice du premier caractère du mot dans le texte, si le mot est
  *       trouvé, -1 sinon, ou -2 en cas d'erreur.
  */
-int naifBoucleRapide(char* text, char* word, int textLength, int wordLength) {
+ptrdiff_t naifBoucleRapide(char* text, char* word, ptrdiff_t textLength, int wordLength) {
     // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
     if (text == NULL || word == NULL) {
         return -2;
@@ -102,7 +185,7 @@ int naifBoucleRapide(char* text, char* word, int textLength, int wordLength) {
     // Recherche du mot dans le texte (boucle rapide).
     // On stocke le dernier caractère du mot dans une variable.
     char lastChar = word[wordLength - 1];
-    for (int i = 0; i < textLength - wordLength + 1; i++) {
+    for (ptrdiff_t i = 0; i < textLength - wordLength + 1; i++) {
         // Si le dernier caractère du mot est différent du dernier caractère du
         // texte, on passe au caractère suivant du texte.
         if (lastChar != text[i + wordLength - 1]) {
@@ -141,7 +224,7 @@ int naifBoucleRapide(char* text, char* word, int textLength, int wordLength) {
  * @return l'indice du premier caractère du mot dans le texte, si le mot est
  *       trouvé, -1 sinon, ou -2 en cas d'erreur.
  */
-int naifSentinelle(char* text, char* word, int textLength, int wordLength) {
+ptrdiff_t naifSentinelle(char* text, char* word, ptrdiff_t textLength, int wordLength) {
     // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
     if (text == NULL || word == NULL) {
         return -2;
@@ -158,7 +241,7 @@ int naifSentinelle(char* text, char* word, int textLength, int wordLength) {
     // Recherche du mot dans le texte (boucle rapide).
     // On stocke le dernier caractère du mot dans une variable.
     char lastChar = word[wordLength - 1];
-    for (int i = 0; i < textLength - wordLength + 1; i++) {
+    for (ptrdiff_t i = 0; i < textLength - wordLength + 1; i++) {
         // Si le dernier caractère du mot est différent du dernier caractère du
         // texte, on passe au caractère suivant du texte.
         if (lastChar != text[i + wordLength - 1]) {
@@ -201,7 +284,7 @@ int naifSentinelle(char* text, char* word, int textLength, int wordLength) {
  * @return l'indice du premier caractère du mot dans le texte, si le mot est
  *        trouvé, -1 sinon, ou -2 en cas d'erreur.
 */
-int naifStrncmp(char* text, char* word, int textLength, int wordLength) {
+ptrdiff_t naifStrncmp(char* text, char* word, ptrdiff_t textLength, int wordLength) {
     // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
     if (text == NULL || word == NULL) {
         return -2;
@@ -213,7 +296,7 @@ int naifStrncmp(char* text, char* word, int textLength, int wordLength) {
     }
 
     // Recherche du mot dans le texte.
-    for (int i = 0; i < textLength - wordLength + 1; i++) {
+    for (ptrdiff_t i = 0; i < textLength - wordLength + 1; i++) {
         // Si le mot n'est pas trouvé à l'indice i, on saute le nombre de
         // caractères correspondant à la longueur du mot.
         if (strncmp(text + i, word, (size_t) wordLength) != 0) {
@@ -245,7 +328,7 @@ int naifStrncmp(char* text, char* word, int textLength, int wordLength) {
  * @return l'indice du premier caractère du mot dans le texte, si le mot est
  *        trouvé, -1 sinon, ou -2 en cas d'erreur.
 */
-int naifRapideStrncmp(char* text, char* word, int textLength, int wordLength) {
+ptrdiff_t naifRapideStrncmp(char* text, char* word, ptrdiff_t textLength, int wordLength) {
     // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
     if (text == NULL || word == NULL) {
         return -2;
@@ -260,7 +343,7 @@ int naifRapideStrncmp(char* text, char* word, int textLength, int wordLength) {
     // On stocke le dernier caractère du mot dans une variable.
     char lastChar = word[wordLength - 1];
     // On utilise strncmp pour les comparaisons
-    for (int i = 0; i < textLength - wordLength + 1; i++) {
+    for (ptrdiff_t i = 0; i < textLength - wordLength + 1; i++) {
         // Si le dernier caractère du mot est différent du dernier caractère du
         // texte, on passe au caractère suivant du texte.
         if (lastChar != text[i + wordLength - 1]) {
@@ -297,7 +380,7 @@ int naifRapideStrncmp(char* text, char* word, int textLength, int wordLength) {
  * @return l'indice du premier caractère du mot dans le texte, si le mot est
  *        trouvé, -1 sinon, ou -2 en cas d'erreur.
 */
-int naifSentinelleStrncmp(char* text, char* word, int textLength, int wordLength) {
+ptrdiff_t naifSentinelleStrncmp(char* text, char* word, ptrdiff_t textLength, int wordLength) {
     // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
     if (text == NULL || word == NULL) {
         return -2;
@@ -315,7 +398,7 @@ int naifSentinelleStrncmp(char* text, char* word, int textLength, int wordLength
     // On stocke le dernier caractère du mot dans une variable.
     char lastChar = word[wordLength - 1];
     // On utilise strncmp pour les comparaisons
-    for (int i = 0; i < textLength - wordLength + 1; i++) {
+    for (ptrdiff_t i = 0; i < textLength - wordLength + 1; i++) {
         // Si le dernier caractère du mot est différent du dernier caractère du
         // texte, on passe au caractère suivant du texte.
         if (lastChar != text[i + wordLength - 1]) {
@@ -383,7 +466,7 @@ int bonPrefTable(char* word, int wordLength, int* bonPref) {
  * @return l'indice du premier caractère du mot dans le texte, si le mot est
  *       trouvé, -1 sinon, ou -2 en cas d'erreur.
  */
-int morrisPratt(char* text, char* word, int textLength, int wordLength, int* bonPref) {
+ptrdiff_t morrisPratt(char* text, char* word, ptrdiff_t textLength, int wordLength, int* bonPref) {
     // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
     if (text == NULL || word == NULL) {
         return -2;
@@ -395,7 +478,7 @@ int morrisPratt(char* text, char* word, int textLength, int wordLength, int* bon
     }
 
     // Recherche du mot dans le texte.
-    int i = 0;
+    ptrdiff_t i = 0;
     int j = 0;
     while (i < textLength) {
         if (text[i] == word[j]) {
@@ -468,7 +551,7 @@ int meilPrefTable(char* word, int wordLength, int* meilPref) {
  * @return l'indice du premier caractère du mot dans le texte, si le mot est
  *       trouvé, -1 sinon, ou -2 en cas d'erreur.
  */
-int knuthMorrisPratt(char* text, char* word, int textLength, int wordLength, int* meilPref) {
+ptrdiff_t knuthMorrisPratt(char* text, char* word, ptrdiff_t textLength, int wordLength, int* meilPref) {
     // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
     if (text == NULL || word == NULL) {
         return -2;
@@ -480,7 +563,7 @@ int knuthMorrisPratt(char* text, char* word, int textLength, int wordLength, int
     }
 
     // Recherche du mot dans le texte.
-    int i = 0;
+    ptrdiff_t i = 0;
     int j = 0;
     while (i < textLength) {
         if (text[i] == word[j]) {
@@ -507,85 +590,113 @@ int knuthMorrisPratt(char* text, char* word, int textLength, int wordLength, int
 ////////////////////////////////////////////////////////////////////////////////
 
 /*
- * Fonction qui calcule la table Suff de Boyer-Moore.
+ * Fonction qui calcule la table Suff de Boyer-Moore, en temps linéaire.
+ * suff[i] est la longueur du plus long suffixe commun au mot et à
+ * word[0..i]. Les valeurs déjà calculées sont réutilisées tant que i reste
+ * dans le dernier suffixe reconnu word[g + 1..f].
  *
  * @param word mot pour lequel calculer la table Suff.
  * @param wordLength longueur du mot.
- * @param suff table Suff.
- * @return 0 en cas de succès, -1 en cas d'erreur.
+ * @param suff table Suff, de taille wordLength.
  */
 void suffTable(char* word, int wordLength, int* suff) {
-    // Initialisation de la table Suff.
-    for (int i = 0; i < wordLength; i++) {
-        suff[i] = wordLength;
-    }
-
-    // Calcul de la table Suff.
+    suff[wordLength - 1] = wordLength;
+    int f = wordLength - 1;
+    int g = wordLength - 1;
     for (int i = wordLength - 2; i >= 0; i--) {
-        int j = i;
-        while (j >= 0 && word[j] == word[wordLength - 1 - i + j]) {
-            j--;
+        if (i > g && suff[i + wordLength - 1 - f] < i - g) {
+            // Valeur connue, recopiée depuis la fin du mot.
+            suff[i] = suff[i + wordLength - 1 - f];
+        } else {
+            // Comparaison explicite, à partir de la limite g.
+            if (i < g) {
+                g = i;
+            }
+            f = i;
+            while (g >= 0 && word[g] == word[g + wordLength - 1 - f]) {
+                g--;
+            }
+            suff[i] = f - g;
         }
-        suff[i] = i - j;
     }
 }
 
 /*
- * Fonction qui calcule la table Good de Boyer-Moore.
+ * Fonction qui calcule la table BonSuff (bon suffixe) de Boyer-Moore.
+ * bonSuff[j] est le décalage à appliquer quand word[j + 1..] est reconnu et
+ * que word[j] échoue : il aligne ce suffixe sur sa réoccurrence la plus à
+ * droite précédée d'une autre lettre, ou à défaut sur le plus long bord du
+ * mot. bonSuff[0] est la période du mot.
  *
  * @param word mot pour lequel calculer la table BonSuff.
  * @param wordLength longueur du mot.
- * @param suff table Suff.
- * @param good table Good.
- * @return 0 en cas de succès, -1 en cas d'erreur.
+ * @param suff table Suff, de taille wordLength, remplie par suffTable().
+ * @param bonSuff table BonSuff, de taille wordLength.
  */
-void bonSuffTable(char* word, int wordLength, int* bonSuff) {
+void bonSuffTable(char* word, int wordLength, int* suff, int* bonSuff) {
+    // Calcul de la table Suff.
+    suffTable(word, wordLength, suff);
+
     // Initialisation de la table BonSuff.
-    for (int i = 0; i < 256; i++) {
+    for (int i = 0; i < wordLength; i++) {
         bonSuff[i] = wordLength;
     }
 
-    // Calcul de la table BonSuff.
-    for (int i = 0; i < wordLength - 1; i++) {
-        bonSuff[(int) word[i]] = wordLength - 1 - i;
+    // Cas où seul un bord du mot peut être aligné (word[0..i] est un suffixe).
+    int j = 0;
+    for (int i = wordLength - 1; i >= 0; i--) {
+        if (suff[i] == i + 1) {
+            for (; j < wordLength - 1 - i; j++) {
+                if (bonSuff[j] == wordLength) {
+                    bonSuff[j] = wordLength - 1 - i;
+                }
+            }
+        }
+    }
+
+    // Cas où le suffixe réapparaît dans le mot : la réoccurrence la plus à
+    // droite l'emporte.
+    for (int i = 0; i <= wordLength - 2; i++) {
+        bonSuff[wordLength - 1 - suff[i]] = wordLength - 1 - i;
     }
 }
 
 /*
- * Searches for the given word in the given text using the Boyer-Moore algorithm.
- *
- * @param text the text in which to search for the word.
- * @param textLength the length of the text.
- * @param word the word to search for in the text.
- * @param wordLength the length of the word.
- * @param suff the suffix table for the word.
- * @param bonSuff the bad-character table for the word.
- * @return the index of the first character of the word in the text, if the word
- *         is found, or -1 if the word is not found.
- */
-int boyerMoore(char* text, int textLength, char* word, int wordLength, int* suff, int* bonSuff) {
-    // Commencer à la fin du mot.
-    int i = wordLength - 1;
-    // Tant qu'on n'est pas arrivé à la fin du texte.
-    while (i < textLength) {
-        // Commencer à la fin du mot.
+ * Fonction qui recherche le mot word dans le texte text en utilisant
+ * l'algorithme de Boyer-Moore.
+ * En cas d'échec sur word[j], la fenêtre est décalée du maximum entre le
+ * décalage du bon suffixe et celui du mauvais caractère.
+ *
+ * @param text le texte dans lequel rechercher le mot.
+ * @param textLength la longueur du texte.
+ * @param word le mot à rechercher dans le texte.
+ * @param wordLength la longueur du mot.
+ * @param bonSuff la table BonSuff du mot (voir bonSuffTable()).
+ * @param dernOcc la table dernOcc du mot (voir dernOccTable()).
+ * @return l'indice du premier caractère du mot dans le texte, si le mot est
+ *        trouvé, -1 sinon, ou -2 en cas d'erreur.
+ */
+ptrdiff_t boyerMoore(char* text, ptrdiff_t textLength, char* word, int wordLength, int* bonSuff, int* dernOcc) {
+    // Test d'erreur. Si le texte, le mot ou une table est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || bonSuff == NULL || dernOcc == NULL || wordLength <= 0) {
+        return -2;
+    }
+
+    ptrdiff_t i = 0;
+    // Tant que la fenêtre est dans le texte.
+    while (i <= textLength - wordLength) {
+        // Comparaison de droite à gauche.
         int j = wordLength - 1;
-        // Tant qu'on n'est pas arrivé au début du mot et que le caractère
-        while (j >= 0 && text[i] == word[j]) {
-            // Move to the previous character.
-            i--;
+        while (j >= 0 && text[i + j] == word[j]) {
             j--;
         }
         // Si on est arrivé au début du mot, le mot a été trouvé.
-        if (j == -1) {
-            return i + 1;
-        }
-        // Sinon, on décale le mot de suff[j] caractères.
-        if (bonSuff[(int) text[i]] > suff[j]) {
-            i += bonSuff[(int) text[i]];
-        } else {
-            i += suff[j];
+        if (j < 0) {
+            return i;
         }
+        // Sinon, on applique le plus grand des deux décalages.
+        int shift = dernOcc[(unsigned char) text[i + j]] - (wordLength - 1 - j);
+        i += bonSuff[j] > shift ? bonSuff[j] : shift;
     }
     // Le mot n'a pas été trouvé.
     return -1;
@@ -606,9 +717,10 @@ void dernOccTable(char* word, int wordLength, int* dernOcc) {
         dernOcc[i] = wordLength;
     }
 
-    // Calculer la table dernOcc.
-    for (int i = wordLength - 2; i >= 0; i--) {
-        dernOcc[(int) word[i]] = wordLength - 1 - i;
+    // Calculer la table dernOcc (de gauche à droite, pour que la dernière
+    // occurrence de chaque caractère l'emporte).
+    for (int i = 0; i < wordLength - 1; i++) {
+        dernOcc[(unsigned char) word[i]] = wordLength - 1 - i;
     }
 }
 
@@ -624,7 +736,7 @@ void dernOccTable(char* word, int wordLength, int* dernOcc) {
  * @return l'indice du premier caractère du mot dans le texte, si le mot est
  *        trouvé, ou -1 si le mot n'est pas trouvé.
  */
-int horspool(char* text, int textLength, char* word, int wordLength, int* dernOcc) {
+ptrdiff_t horspool(char* text, ptrdiff_t textLength, char* word, int wordLength, int* dernOcc) {
     // Test d'erreur. Si le mot est plus long que le texte, on renvoie -1.
     if (wordLength > textLength) {
         return -1;
@@ -632,7 +744,7 @@ int horspool(char* text, int textLength, char* word, int wordLength, int* dernOc
 
     // Recherche du mot dans le texte en utilisant la table dernOcc.
     // From the last character of the word.
-    int i = wordLength - 1;
+    ptrdiff_t i = wordLength - 1;
     // While there are still characters to check in the text.
     while (i < textLength) {
         // From the last character of the word.
@@ -649,8 +761,2180 @@ int horspool(char* text, int textLength, char* word, int wordLength, int* dernOc
             return i + 1;
         }
         // Move to the next character in the text.
-        i += dernOcc[(int) text[i]];
+        i += dernOcc[(unsigned char) text[i]];
     }
     // The word was not found.
     return -1;
-}
\ No newline at end of file
+}
+////////////////////////////////////////////////////////////////////////////////
+// Toutes les occurrences
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Les fonctions suivantes sont les variantes "Occurrences" des algorithmes
+ * ci-dessus. Elles trouvent toutes les occurrences du mot en une seule passe
+ * sur le texte : le prétraitement est fait une fois par l'appelant, et l'état
+ * de l'algorithme (automate de MP/KMP, décalages de Boyer-Moore) est conservé
+ * d'une occurrence à la suivante, au lieu de relancer la recherche depuis
+ * text + i.
+ *
+ * Chaque occurrence est transmise, dans l'ordre croissant des indices, à la
+ * fonction report. Si report est NULL, les occurrences sont seulement
+ * comptées.
+ *
+ * Chaque fonction "Occurrences" a une version "Count" (naifCount(),
+ * horspoolCount(), ...), sans report ni data, regroupées à la fin du fichier
+ * ("Versions comptage seul"). La plupart se contentent d'appeler la version
+ * "Occurrences" avec report = NULL et ne sont pas plus rapides qu'elle : le
+ * test de report est bien prédit et ne coûte presque rien. Seuls les noyaux
+ * vectorisés (popcount du masque des candidats pour les mots de 1 ou 2
+ * caractères) et shiftOrCount() ont une boucle propre.
+ */
+
+/**
+ * Type des fonctions appelées pour chaque occurrence trouvée.
+ * Renvoie 0 pour continuer la recherche, une autre valeur pour l'arrêter.
+ *
+ * @param index indice du premier caractère de l'occurrence dans le texte.
+ * @param data donnée transmise par l'appelant.
+ */
+typedef int (*occurrenceCallback)(ptrdiff_t index, void* data);
+
+/**
+ * Type des fonctions de recherche de toutes les occurrences qui n'ont besoin
+ * d'aucune table précalculée (naifOccurrences(), shiftOrOccurrences(), ...).
+ */
+typedef long long (*occurrenceSearch)(char* text, char* word, ptrdiff_t textLength, int wordLength, occurrenceCallback report, void* data);
+
+/**
+ * Type des versions "Count" des fonctions de type occurrenceSearch
+ * (naifCount(), shiftOrCount(), ...).
+ */
+typedef long long (*countSearch)(char* text, char* word, ptrdiff_t textLength, int wordLength);
+
+/**
+ * Tampon de sortie des occurrences, rempli par storeOccurrence.
+ */
+struct occurrenceBuffer {
+    ptrdiff_t* indices; // Indices des occurrences
+    long long capacity; // Nombre maximal d'indices stockés
+    long long count; // Nombre d'occurrences rencontrées (peut dépasser capacity)
+};
+
+/**
+ * Fonction de rappel qui stocke les occurrences dans un occurrenceBuffer.
+ * Les occurrences au-delà de la capacité du tampon sont seulement comptées.
+ *
+ * @param index indice de l'occurrence.
+ * @param data pointeur vers un struct occurrenceBuffer.
+ * @return 0 (la recherche continue).
+ */
+int storeOccurrence(ptrdiff_t index, void* data) {
+    struct occurrenceBuffer* buffer = (struct occurrenceBuffer*) data;
+    if (buffer->count < buffer->capacity) {
+        buffer->indices[buffer->count] = index;
+    }
+    buffer->count += 1;
+    return 0;
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme naif, avec boucle interne, sans boucle rapide, sans
+ * sentinelle.
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long naifOccurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+
+    long long count = 0;
+    for (ptrdiff_t i = 0; i <= textLength - wordLength; i++) {
+        // Boucle interne.
+        int j = 0;
+        while (j < wordLength && text[i + j] == word[j]) {
+            j++;
+        }
+        // Occurrence trouvée.
+        if (j == wordLength) {
+            count++;
+            if (report != NULL && report(i, data) != 0) {
+                return count;
+            }
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme naif, avec boucle interne, avec boucle rapide, sans
+ * sentinelle.
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long naifBoucleRapideOccurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+
+    long long count = 0;
+    char lastChar = word[wordLength - 1];
+    for (ptrdiff_t i = 0; i <= textLength - wordLength; i++) {
+        // Boucle rapide sur le dernier caractère du mot.
+        if (lastChar != text[i + wordLength - 1]) {
+            continue;
+        }
+        // Boucle interne.
+        int j = 0;
+        while (j < wordLength - 1 && text[i + j] == word[j]) {
+            j++;
+        }
+        // Occurrence trouvée.
+        if (j == wordLength - 1) {
+            count++;
+            if (report != NULL && report(i, data) != 0) {
+                return count;
+            }
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme naif, avec boucle interne, avec boucle rapide, avec
+ * sentinelle.
+ * La sentinelle est écrite en text[textLength] (qui doit donc être accessible
+ * en écriture), puis le caractère d'origine est restauré.
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long naifSentinelleOccurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+    if (wordLength > textLength) {
+        return 0;
+    }
+
+    // Ajout de la sentinelle : la boucle rapide s'arrête au plus tard en
+    // i = textLength - wordLength + 1, sans test de fin de texte.
+    char saved = text[textLength];
+    char lastChar = word[wordLength - 1];
+    text[textLength] = lastChar;
+
+    long long count = 0;
+    ptrdiff_t i = 0;
+    while (1) {
+        // Boucle rapide sur le dernier caractère du mot.
+        while (text[i + wordLength - 1] != lastChar) {
+            i++;
+        }
+        // On a atteint la sentinelle.
+        if (i > textLength - wordLength) {
+            break;
+        }
+        // Boucle interne.
+        int j = 0;
+        while (j < wordLength - 1 && text[i + j] == word[j]) {
+            j++;
+        }
+        // Occurrence trouvée.
+        if (j == wordLength - 1) {
+            count++;
+            if (report != NULL && report(i, data) != 0) {
+                break;
+            }
+        }
+        i++;
+    }
+
+    // Retrait de la sentinelle.
+    text[textLength] = saved;
+    return count;
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme naif, sans boucle rapide, sans sentinelle, avec
+ * strncmp().
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long naifStrncmpOccurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+
+    long long count = 0;
+    for (ptrdiff_t i = 0; i <= textLength - wordLength; i++) {
+        if (strncmp(text + i, word, (size_t) wordLength) == 0) {
+            count++;
+            if (report != NULL && report(i, data) != 0) {
+                return count;
+            }
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme naif, avec boucle rapide, sans sentinelle, avec
+ * strncmp().
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long naifRapideStrncmpOccurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+
+    long long count = 0;
+    char lastChar = word[wordLength - 1];
+    for (ptrdiff_t i = 0; i <= textLength - wordLength; i++) {
+        // Boucle rapide sur le dernier caractère du mot.
+        if (lastChar != text[i + wordLength - 1]) {
+            continue;
+        }
+        if (strncmp(text + i, word, (size_t) wordLength) == 0) {
+            count++;
+            if (report != NULL && report(i, data) != 0) {
+                return count;
+            }
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme naif, avec boucle rapide, avec sentinelle, avec
+ * strncmp().
+ * La sentinelle est écrite en text[textLength] (qui doit donc être accessible
+ * en écriture), puis le caractère d'origine est restauré.
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long naifSentinelleStrncmpOccurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+    if (wordLength > textLength) {
+        return 0;
+    }
+
+    // Ajout de la sentinelle.
+    char saved = text[textLength];
+    char lastChar = word[wordLength - 1];
+    text[textLength] = lastChar;
+
+    long long count = 0;
+    ptrdiff_t i = 0;
+    while (1) {
+        // Boucle rapide sur le dernier caractère du mot.
+        while (text[i + wordLength - 1] != lastChar) {
+            i++;
+        }
+        // On a atteint la sentinelle.
+        if (i > textLength - wordLength) {
+            break;
+        }
+        if (strncmp(text + i, word, (size_t) wordLength) == 0) {
+            count++;
+            if (report != NULL && report(i, data) != 0) {
+                break;
+            }
+        }
+        i++;
+    }
+
+    // Retrait de la sentinelle.
+    text[textLength] = saved;
+    return count;
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme de Morris-Pratt. Après une occurrence, on continue
+ * depuis l'état bonPref[wordLength] de l'automate, sans relire le texte.
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param bonPref table de préfixes de Bon-Pré (wordLength + 1 cases).
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long morrisPrattOccurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, int* bonPref, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte, le mot ou la table est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || bonPref == NULL || wordLength <= 0) {
+        return -2;
+    }
+
+    long long count = 0;
+    int j = 0;
+    for (ptrdiff_t i = 0; i < textLength; i++) {
+        while (j >= 0 && text[i] != word[j]) {
+            j = bonPref[j];
+        }
+        j += 1;
+        if (j == wordLength) {
+            count++;
+            if (report != NULL && report(i - wordLength + 1, data) != 0) {
+                return count;
+            }
+            j = bonPref[wordLength];
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme de Knuth-Morris-Pratt. Après une occurrence, on
+ * continue depuis l'état meilPref[wordLength] de l'automate, sans relire le
+ * texte.
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param meilPref table de préfixes de Meil-Pré (wordLength + 1 cases).
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long knuthMorrisPrattOccurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, int* meilPref, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte, le mot ou la table est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || meilPref == NULL || wordLength <= 0) {
+        return -2;
+    }
+
+    long long count = 0;
+    int j = 0;
+    for (ptrdiff_t i = 0; i < textLength; i++) {
+        while (j >= 0 && text[i] != word[j]) {
+            j = meilPref[j];
+        }
+        j += 1;
+        if (j == wordLength) {
+            count++;
+            if (report != NULL && report(i - wordLength + 1, data) != 0) {
+                return count;
+            }
+            j = meilPref[wordLength];
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme de Boyer-Moore avec la règle de Galil.
+ * En cas d'échec, la fenêtre est décalée du maximum entre le bon suffixe et
+ * le mauvais caractère. Après une occurrence, elle est décalée de la période
+ * du mot (bonSuff[0]) et le préfixe de longueur wordLength - période, déjà
+ * connu, n'est pas recomparé : le temps est linéaire dans le pire cas.
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param textLength longueur du texte.
+ * @param word mot à rechercher dans le texte.
+ * @param wordLength longueur du mot.
+ * @param bonSuff table BonSuff du mot (voir bonSuffTable()).
+ * @param dernOcc table dernOcc du mot (voir dernOccTable()).
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long boyerMooreOccurrences(char* text, ptrdiff_t textLength, char* word, int wordLength, int* bonSuff, int* dernOcc, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte, le mot ou une table est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || bonSuff == NULL || dernOcc == NULL || wordLength <= 0) {
+        return -2;
+    }
+
+    int period = bonSuff[0];
+    long long count = 0;
+    ptrdiff_t i = 0;
+    // Limite de comparaison (règle de Galil) : word[0..limit - 1] est connu.
+    int limit = 0;
+    while (i <= textLength - wordLength) {
+        // Comparaison de droite à gauche.
+        int j = wordLength - 1;
+        while (j >= limit && COMPARE(text[i + j], word[j])) {
+            j--;
+        }
+        if (j < limit) {
+            // Occurrence trouvée.
+            count++;
+            if (report != NULL && report(i, data) != 0) {
+                return count;
+            }
+            i += period;
+            limit = wordLength - period;
+        } else {
+            // Plus grand des décalages du bon suffixe et du mauvais caractère.
+            int shift = dernOcc[(unsigned char) text[i + j]] - (wordLength - 1 - j);
+            i += bonSuff[j] > shift ? bonSuff[j] : shift;
+            limit = 0;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme de Horspool.
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param textLength longueur du texte.
+ * @param word mot à rechercher dans le texte.
+ * @param wordLength longueur du mot.
+ * @param dernOcc table dernOcc du mot (256 cases).
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long horspoolOccurrences(char* text, ptrdiff_t textLength, char* word, int wordLength, int* dernOcc, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte, le mot ou la table est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || dernOcc == NULL || wordLength <= 0) {
+        return -2;
+    }
+
+    long long count = 0;
+    ptrdiff_t i = 0;
+    while (i <= textLength - wordLength) {
+        // Dernier caractère de la fenêtre, qui détermine le décalage.
+        unsigned char c = (unsigned char) text[i + wordLength - 1];
+        // Comparaison de droite à gauche.
+        int j = wordLength - 1;
+        while (j >= 0 && text[i + j] == word[j]) {
+            j--;
+        }
+        if (j < 0) {
+            // Occurrence trouvée.
+            count++;
+            if (report != NULL && report(i, data) != 0) {
+                return count;
+            }
+        }
+        i += dernOcc[c];
+    }
+
+    return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Naif vectorisé
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Version vectorisée de la boucle rapide : on compare le premier et le dernier
+ * caractère du mot à 32 (AVX2) ou 16 (SSE2) positions du texte à la fois, on
+ * fait le ET des deux masques, et on ne vérifie que les positions candidates.
+ * Le jeu d'instructions est choisi à l'exécution. Les dernières positions
+ * (moins d'un bloc) sont traitées par une boucle scalaire.
+ */
+
+/**
+ * Fonction qui termine une recherche naive avec boucle rapide, de la position
+ * start à la fin du texte (queue scalaire des versions vectorisées).
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param start première position à tester.
+ * @param count nombre d'occurrences déjà trouvées.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre total d'occurrences trouvées.
+ */
+long long naifQueueOccurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, ptrdiff_t start, long long count, occurrenceCallback report, void* data) {
+    char firstChar = word[0];
+    char lastChar = word[wordLength - 1];
+    for (ptrdiff_t i = start; i <= textLength - wordLength; i++) {
+        if (text[i] != firstChar || text[i + wordLength - 1] != lastChar) {
+            continue;
+        }
+        if (wordLength <= 2 || memcmp(text + i + 1, word + 1, (size_t) (wordLength - 2)) == 0) {
+            count++;
+            if (report != NULL && report(i, data) != 0) {
+                return count;
+            }
+        }
+    }
+    return count;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/**
+ * Noyau SSE2 de naifSimdOccurrences (16 positions par itération).
+ * Mêmes paramètres et valeur de retour que naifSimdOccurrences.
+ */
+__attribute__((target("sse2")))
+long long naifSse2Occurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, occurrenceCallback report, void* data) {
+    __m128i firstChar = _mm_set1_epi8(word[0]);
+    __m128i lastChar = _mm_set1_epi8(word[wordLength - 1]);
+    long long count = 0;
+    ptrdiff_t i = 0;
+    // Blocs de 16 positions i..i+15, tous de la forme i <= textLength - wordLength.
+    for (; i + 16 <= textLength - wordLength + 1; i += 16) {
+        __m128i blockFirst = _mm_loadu_si128((const __m128i*) (text + i));
+        __m128i blockLast = _mm_loadu_si128((const __m128i*) (text + i + wordLength - 1));
+        __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(firstChar, blockFirst), _mm_cmpeq_epi8(lastChar, blockLast));
+        unsigned int mask = (unsigned int) _mm_movemask_epi8(eq);
+        // Comptage seul d'un mot de 1 ou 2 caractères : chaque candidat est
+        // une occurrence.
+        if (report == NULL && wordLength <= 2) {
+            count += __builtin_popcount(mask);
+            continue;
+        }
+        // Vérification des positions candidates, dans l'ordre.
+        while (mask != 0) {
+            int k = __builtin_ctz(mask);
+            if (wordLength <= 2 || memcmp(text + i + k + 1, word + 1, (size_t) (wordLength - 2)) == 0) {
+                count++;
+                if (report != NULL && report(i + k, data) != 0) {
+                    return count;
+                }
+            }
+            mask &= mask - 1;
+        }
+    }
+    return naifQueueOccurrences(text, word, textLength, wordLength, i, count, report, data);
+}
+
+/**
+ * Noyau AVX2 de naifSimdOccurrences (32 positions par itération).
+ * Mêmes paramètres et valeur de retour que naifSimdOccurrences.
+ */
+__attribute__((target("avx2")))
+long long naifAvx2Occurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, occurrenceCallback report, void* data) {
+    __m256i firstChar = _mm256_set1_epi8(word[0]);
+    __m256i lastChar = _mm256_set1_epi8(word[wordLength - 1]);
+    long long count = 0;
+    ptrdiff_t i = 0;
+    // Blocs de 32 positions i..i+31, tous de la forme i <= textLength - wordLength.
+    for (; i + 32 <= textLength - wordLength + 1; i += 32) {
+        __m256i blockFirst = _mm256_loadu_si256((const __m256i*) (text + i));
+        __m256i blockLast = _mm256_loadu_si256((const __m256i*) (text + i + wordLength - 1));
+        __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(firstChar, blockFirst), _mm256_cmpeq_epi8(lastChar, blockLast));
+        unsigned int mask = (unsigned int) _mm256_movemask_epi8(eq);
+        // Comptage seul d'un mot de 1 ou 2 caractères : chaque candidat est
+        // une occurrence.
+        if (report == NULL && wordLength <= 2) {
+            count += __builtin_popcount(mask);
+            continue;
+        }
+        // Vérification des positions candidates, dans l'ordre.
+        while (mask != 0) {
+            int k = __builtin_ctz(mask);
+            if (wordLength <= 2 || memcmp(text + i + k + 1, word + 1, (size_t) (wordLength - 2)) == 0) {
+                count++;
+                if (report != NULL && report(i + k, data) != 0) {
+                    return count;
+                }
+            }
+            mask &= mask - 1;
+        }
+    }
+    return naifQueueOccurrences(text, word, textLength, wordLength, i, count, report, data);
+}
+
+#endif
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme naif avec boucle rapide vectorisée (AVX2 si le
+ * processeur le permet, SSE2 sinon, et boucle scalaire hors x86).
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long naifSimdOccurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    if (__builtin_cpu_supports("avx2")) {
+        return naifAvx2Occurrences(text, word, textLength, wordLength, report, data);
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return naifSse2Occurrences(text, word, textLength, wordLength, report, data);
+    }
+#endif
+    return naifQueueOccurrences(text, word, textLength, wordLength, 0, 0, report, data);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Two-Way (Crochemore-Perrin)
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Fonction qui calcule le suffixe maximal d'un mot pour l'ordre
+ * lexicographique (ou pour l'ordre inverse), ainsi que sa période.
+ *
+ * @param word mot dont on calcule le suffixe maximal.
+ * @param wordLength longueur du mot.
+ * @param period période du suffixe maximal (résultat).
+ * @param inverse 0 pour l'ordre lexicographique, 1 pour l'ordre inverse.
+ * @return l'indice du caractère qui précède le suffixe maximal (-1 si le
+ *         suffixe maximal est le mot entier).
+ */
+int suffixeMaximal(char* word, int wordLength, int* period, int inverse) {
+    int ms = -1;
+    int j = 0;
+    int k = 1;
+    *period = 1;
+    while (j + k < wordLength) {
+        unsigned char a = (unsigned char) word[j + k];
+        unsigned char b = (unsigned char) word[ms + k];
+        if (inverse ? a > b : a < b) {
+            // Le suffixe candidat est plus petit : on l'étend.
+            j += k;
+            k = 1;
+            *period = j - ms;
+        } else if (a == b) {
+            // Avance dans la période courante.
+            if (k != *period) {
+                k += 1;
+            } else {
+                j += *period;
+                k = 1;
+            }
+        } else {
+            // Nouveau suffixe maximal candidat.
+            ms = j;
+            j = ms + 1;
+            k = 1;
+            *period = 1;
+        }
+    }
+    return ms;
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme Two-Way de Crochemore et Perrin.
+ * Le mot est coupé en une factorisation critique u.v, calculée à partir des
+ * deux suffixes maximaux du mot. On compare v de gauche à droite, puis u de
+ * droite à gauche. Si le mot est périodique, on mémorise le préfixe déjà
+ * reconnu après un décalage d'une période.
+ * Le temps est linéaire dans le pire cas et la mémoire supplémentaire
+ * constante : aucune table n'est allouée.
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long twoWayOccurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+
+    // Factorisation critique : on garde le plus long des deux suffixes
+    // maximaux (ell est la fin de u).
+    int p = 0;
+    int q = 0;
+    int i = suffixeMaximal(word, wordLength, &p, 0);
+    int j = suffixeMaximal(word, wordLength, &q, 1);
+    int ell = i > j ? i : j;
+    int period = i > j ? p : q;
+
+    long long count = 0;
+    if (memcmp(word, word + period, (size_t) (ell + 1)) == 0) {
+        // Mot périodique : après une occurrence, le préfixe de longueur
+        // wordLength - period est déjà reconnu (memory).
+        int memory = -1;
+        ptrdiff_t pos = 0;
+        while (pos <= textLength - wordLength) {
+            // Partie droite v, de gauche à droite.
+            i = (ell > memory ? ell : memory) + 1;
+            while (i < wordLength && word[i] == text[i + pos]) {
+                i++;
+            }
+            if (i >= wordLength) {
+                // Partie gauche u, de droite à gauche.
+                i = ell;
+                while (i > memory && word[i] == text[i + pos]) {
+                    i--;
+                }
+                if (i <= memory) {
+                    count++;
+                    if (report != NULL && report(pos, data) != 0) {
+                        return count;
+                    }
+                }
+                pos += period;
+                memory = wordLength - period - 1;
+            } else {
+                pos += i - ell;
+                memory = -1;
+            }
+        }
+    } else {
+        // Mot non périodique : le décalage après un échec sur u (ou une
+        // occurrence) est au moins max(|u|, |v|) + 1.
+        period = (ell + 1 > wordLength - ell - 1 ? ell + 1 : wordLength - ell - 1) + 1;
+        ptrdiff_t pos = 0;
+        while (pos <= textLength - wordLength) {
+            // Partie droite v, de gauche à droite.
+            i = ell + 1;
+            while (i < wordLength && word[i] == text[i + pos]) {
+                i++;
+            }
+            if (i >= wordLength) {
+                // Partie gauche u, de droite à gauche.
+                i = ell;
+                while (i >= 0 && word[i] == text[i + pos]) {
+                    i--;
+                }
+                if (i < 0) {
+                    count++;
+                    if (report != NULL && report(pos, data) != 0) {
+                        return count;
+                    }
+                }
+                pos += period;
+            } else {
+                pos += i - ell;
+            }
+        }
+    }
+
+    return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Shift-Or
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot de plus de 64
+ * caractères dans un texte, en utilisant l'algorithme Shift-Or sur un état
+ * de plusieurs mots machine de 64 bits.
+ * Le mot d'indice 0 de l'état contient les bits 0 à 63, et la retenue du
+ * décalage passe d'un mot au suivant.
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long shiftOrMultiOccurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+
+    // Nombre de mots machine de l'état, et masque du dernier bit.
+    int nbWords = (wordLength + 63) / 64;
+    uint64_t lastBit = (uint64_t) 1 << ((wordLength - 1) % 64);
+
+    // Allocation des masques (nbWords mots par lettre) et de l'état.
+    uint64_t* masks = malloc(sizeof(uint64_t) * (size_t) (256 + 1) * (size_t) nbWords);
+    // Test d'erreur. Si l'allocation a échoué, on renvoie -2.
+    if (masks == NULL) {
+        perror("malloc");
+        return -2;
+    }
+    uint64_t* state = masks + 256 * nbWords;
+
+    // Le bit i du masque d'une lettre vaut 0 si word[i] est cette lettre.
+    for (int k = 0; k < 256 * nbWords; k++) {
+        masks[k] = ~(uint64_t) 0;
+    }
+    for (int i = 0; i < wordLength; i++) {
+        masks[(unsigned char) word[i] * nbWords + i / 64] &= ~((uint64_t) 1 << (i % 64));
+    }
+    for (int k = 0; k < nbWords; k++) {
+        state[k] = ~(uint64_t) 0;
+    }
+
+    long long count = 0;
+    for (ptrdiff_t j = 0; j < textLength; j++) {
+        uint64_t* mask = masks + (unsigned char) text[j] * nbWords;
+        // Décalage de l'état de poids fort vers poids faible, pour lire la
+        // retenue dans l'ancien mot précédent.
+        for (int k = nbWords - 1; k > 0; k--) {
+            state[k] = (state[k] << 1) | (state[k - 1] >> 63) | mask[k];
+        }
+        state[0] = (state[0] << 1) | mask[0];
+        if ((state[nbWords - 1] & lastBit) == 0) {
+            count++;
+            if (report != NULL && report(j - wordLength + 1, data) != 0) {
+                break;
+            }
+        }
+    }
+
+    free(masks);
+    return count;
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme Shift-Or.
+ * Le bit i de l'état vaut 0 si word[0..i] se termine à la position courante
+ * du texte. Chaque caractère coûte un décalage et un OU, sans branchement
+ * dépendant du mot : le temps ne dépend pas de la taille de l'alphabet.
+ * Les mots de plus de 64 caractères passent par shiftOrMultiOccurrences.
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long shiftOrOccurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+    // Mot trop long pour un seul mot machine.
+    if (wordLength > 64) {
+        return shiftOrMultiOccurrences(text, word, textLength, wordLength, report, data);
+    }
+
+    // Le bit i du masque d'une lettre vaut 0 si word[i] est cette lettre.
+    uint64_t masks[256];
+    for (int c = 0; c < 256; c++) {
+        masks[c] = ~(uint64_t) 0;
+    }
+    for (int i = 0; i < wordLength; i++) {
+        masks[(unsigned char) word[i]] &= ~((uint64_t) 1 << i);
+    }
+    uint64_t lastBit = (uint64_t) 1 << (wordLength - 1);
+
+    long long count = 0;
+    uint64_t state = ~(uint64_t) 0;
+    for (ptrdiff_t j = 0; j < textLength; j++) {
+        state = (state << 1) | masks[(unsigned char) text[j]];
+        if ((state & lastBit) == 0) {
+            count++;
+            if (report != NULL && report(j - wordLength + 1, data) != 0) {
+                return count;
+            }
+        }
+    }
+
+    return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// BNDM et BOM
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme BNDM (Backward Nondeterministic DAWG Matching).
+ * L'automate des suffixes du mot retourné est simulé par un vecteur de bits.
+ * La fenêtre est lue de droite à gauche jusqu'à ce qu'elle ne soit plus un
+ * facteur du mot, puis décalée jusqu'au dernier préfixe reconnu : le temps
+ * moyen est sous-linéaire.
+ * Au-delà de 64 caractères, l'automate est construit sur les 64 premiers
+ * caractères du mot et le reste est vérifié par memcmp().
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long bndmOccurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+
+    // Longueur de la partie du mot simulée par l'automate.
+    int m = wordLength < 64 ? wordLength : 64;
+    uint64_t highBit = (uint64_t) 1 << (m - 1);
+
+    // Le bit m - 1 - i du masque d'une lettre vaut 1 si word[i] est cette
+    // lettre.
+    uint64_t masks[256] = {0};
+    for (int i = 0; i < m; i++) {
+        masks[(unsigned char) word[i]] |= (uint64_t) 1 << (m - 1 - i);
+    }
+
+    long long count = 0;
+    ptrdiff_t pos = 0;
+    while (pos <= textLength - wordLength) {
+        int j = m;
+        int last = m;
+        uint64_t state = masks[(unsigned char) text[pos + j - 1]];
+        while (state != 0) {
+            j--;
+            if ((state & highBit) != 0) {
+                if (j > 0) {
+                    // Préfixe du mot reconnu : prochain décalage.
+                    last = j;
+                } else {
+                    // Fenêtre entière reconnue : on vérifie la fin du mot.
+                    if (m == wordLength || memcmp(word + m, text + pos + m, (size_t) (wordLength - m)) == 0) {
+                        count++;
+                        if (report != NULL && report(pos, data) != 0) {
+                            return count;
+                        }
+                    }
+                    break;
+                }
+            }
+            state = (state << 1) & masks[(unsigned char) text[pos + j - 1]];
+        }
+        pos += last;
+    }
+
+    return count;
+}
+
+/**
+ * Fonction qui construit l'oracle des facteurs du mot retourné.
+ * L'oracle reconnaît au moins tous les facteurs du mot retourné, avec
+ * wordLength + 1 états et au plus 2 * wordLength - 1 transitions.
+ * Les transitions sont rangées dans une matrice (wordLength + 1) x 256,
+ * -1 indiquant l'absence de transition.
+ *
+ * @param word mot dont on construit l'oracle.
+ * @param wordLength longueur du mot.
+ * @param oracle matrice des transitions (résultat).
+ * @param supply table de suppléance, de taille wordLength + 1 (travail).
+ */
+void oracleTable(char* word, int wordLength, int* oracle, int* supply) {
+    for (int k = 0; k < (wordLength + 1) * 256; k++) {
+        oracle[k] = -1;
+    }
+    supply[0] = -1;
+    for (int i = 1; i <= wordLength; i++) {
+        // Lettre i - 1 du mot retourné.
+        unsigned char c = (unsigned char) word[wordLength - i];
+        oracle[(i - 1) * 256 + c] = i;
+        int k = supply[i - 1];
+        while (k > -1 && oracle[k * 256 + c] == -1) {
+            oracle[k * 256 + c] = i;
+            k = supply[k];
+        }
+        supply[i] = k == -1 ? 0 : oracle[k * 256 + c];
+    }
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme BOM (Backward Oracle Matching).
+ * La fenêtre est lue de droite à gauche dans l'oracle des facteurs du mot
+ * retourné. Dès qu'une transition manque, la partie lue n'est pas un
+ * facteur du mot et la fenêtre passe après le caractère fautif. Si toute la
+ * fenêtre est lue, on vérifie l'occurrence et on décale d'un caractère.
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long bomOccurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+
+    // Allocation de l'oracle et de la table de suppléance.
+    int* oracle = malloc(sizeof(int) * (size_t) (wordLength + 1) * 257);
+    // Test d'erreur. Si l'allocation a échoué, on renvoie -2.
+    if (oracle == NULL) {
+        perror("malloc");
+        return -2;
+    }
+    int* supply = oracle + (wordLength + 1) * 256;
+    oracleTable(word, wordLength, oracle, supply);
+
+    long long count = 0;
+    ptrdiff_t pos = 0;
+    while (pos <= textLength - wordLength) {
+        int state = 0;
+        int j = wordLength;
+        while (j > 0 && state != -1) {
+            state = oracle[state * 256 + (unsigned char) text[pos + j - 1]];
+            j--;
+        }
+        if (state != -1) {
+            // Fenêtre entière lue : l'oracle peut accepter des non-facteurs,
+            // on vérifie donc l'occurrence.
+            if (memcmp(word, text + pos, (size_t) wordLength) == 0) {
+                count++;
+                if (report != NULL && report(pos, data) != 0) {
+                    break;
+                }
+            }
+            pos += 1;
+        } else {
+            pos += j + 1;
+        }
+    }
+
+    free(oracle);
+    return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Turbo-BM et Apostolico-Giancarlo
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme Turbo-BM.
+ * Comme Boyer-Moore, mais on mémorise le facteur du mot reconnu lors de la
+ * tentative précédente (de longueur memory) : il est sauté lors de la
+ * comparaison suivante, et un décalage "turbo" évite de le réaligner sur
+ * lui-même. Le nombre de comparaisons est au plus 2n.
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param textLength longueur du texte.
+ * @param word mot à rechercher dans le texte.
+ * @param wordLength longueur du mot.
+ * @param bonSuff table BonSuff du mot (voir bonSuffTable()).
+ * @param dernOcc table dernOcc du mot (voir dernOccTable()).
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long turboBoyerMooreOccurrences(char* text, ptrdiff_t textLength, char* word, int wordLength, int* bonSuff, int* dernOcc, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte, le mot ou une table est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || bonSuff == NULL || dernOcc == NULL || wordLength <= 0) {
+        return -2;
+    }
+
+    long long count = 0;
+    ptrdiff_t i = 0;
+    int memory = 0;
+    int shift = wordLength;
+    while (i <= textLength - wordLength) {
+        // Comparaison de droite à gauche, en sautant le facteur mémorisé.
+        int j = wordLength - 1;
+        while (j >= 0 && COMPARE(text[i + j], word[j])) {
+            j--;
+            if (memory != 0 && j == wordLength - 1 - shift) {
+                j -= memory;
+            }
+        }
+        if (j < 0) {
+            // Occurrence trouvée.
+            count++;
+            if (report != NULL && report(i, data) != 0) {
+                return count;
+            }
+            shift = bonSuff[0];
+            memory = wordLength - shift;
+        } else {
+            // v : longueur du suffixe reconnu.
+            int v = wordLength - 1 - j;
+            int turboShift = memory - v;
+            int bcShift = dernOcc[(unsigned char) text[i + j]] - wordLength + 1 + j;
+            shift = turboShift > bcShift ? turboShift : bcShift;
+            shift = shift > bonSuff[j] ? shift : bonSuff[j];
+            if (shift == bonSuff[j]) {
+                // Décalage du bon suffixe : on mémorise le suffixe reconnu.
+                memory = wordLength - shift < v ? wordLength - shift : v;
+            } else {
+                if (turboShift < bcShift) {
+                    shift = shift > memory + 1 ? shift : memory + 1;
+                }
+                memory = 0;
+            }
+        }
+        i += shift;
+    }
+
+    return count;
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme d'Apostolico-Giancarlo.
+ * Pour chaque position de la fenêtre, skip mémorise la longueur du suffixe
+ * du mot reconnu en cette position du texte lors des tentatives
+ * précédentes. Comparée à suff, elle permet de sauter ces caractères sans
+ * les relire. Le nombre de comparaisons est au plus 2n.
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param textLength longueur du texte.
+ * @param word mot à rechercher dans le texte.
+ * @param wordLength longueur du mot.
+ * @param suff table Suff du mot (remplie par bonSuffTable()).
+ * @param bonSuff table BonSuff du mot (voir bonSuffTable()).
+ * @param dernOcc table dernOcc du mot (voir dernOccTable()).
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long apostolicoGiancarloOccurrences(char* text, ptrdiff_t textLength, char* word, int wordLength, int* suff, int* bonSuff, int* dernOcc, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte, le mot ou une table est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || suff == NULL || bonSuff == NULL || dernOcc == NULL || wordLength <= 0) {
+        return -2;
+    }
+
+    // Allocation de la table skip, initialisée à 0.
+    int* skip = calloc((size_t) wordLength, sizeof(int));
+    // Test d'erreur. Si l'allocation a échoué, on renvoie -2.
+    if (skip == NULL) {
+        perror("calloc");
+        return -2;
+    }
+
+    long long count = 0;
+    ptrdiff_t i = 0;
+    while (i <= textLength - wordLength) {
+        int j = wordLength - 1;
+        while (j >= 0) {
+            int k = skip[j];
+            int s = suff[j];
+            if (k > 0) {
+                // Suffixe de longueur k déjà reconnu en i + j.
+                if (k > s) {
+                    // word[j - s] diffère du texte, sauf si s couvre le
+                    // préfixe entier.
+                    if (j + 1 == s) {
+                        j = -1;
+                    } else {
+                        j -= s;
+                    }
+                    break;
+                }
+                j -= k;
+                if (k < s) {
+                    // word[j] diffère du texte.
+                    break;
+                }
+            } else if (COMPARE(text[i + j], word[j])) {
+                j--;
+            } else {
+                break;
+            }
+        }
+
+        int shift = 0;
+        if (j < 0) {
+            // Occurrence trouvée.
+            count++;
+            if (report != NULL && report(i, data) != 0) {
+                break;
+            }
+            skip[wordLength - 1] = wordLength;
+            shift = bonSuff[0];
+        } else {
+            skip[wordLength - 1] = wordLength - 1 - j;
+            int bcShift = dernOcc[(unsigned char) text[i + j]] - wordLength + 1 + j;
+            shift = bonSuff[j] > bcShift ? bonSuff[j] : bcShift;
+        }
+        i += shift;
+        // Décalage de la table skip avec la fenêtre.
+        memmove(skip, skip + shift, sizeof(int) * (size_t) (wordLength - shift));
+        memset(skip + wordLength - shift, 0, sizeof(int) * (size_t) shift);
+    }
+
+    free(skip);
+    return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Karp-Rabin
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Fonction qui calcule la valeur de hachage de Karp-Rabin d'une chaîne :
+ * somme des s[i] * KARP_RABIN_BASE^(length - 1 - i), modulo 2^32.
+ * Pas de modulo premier : la multiplication déborde naturellement, sans
+ * division, et les faux positifs sont écartés par memcmp().
+ *
+ * @param s chaîne à hacher.
+ * @param length longueur de la chaîne.
+ * @return la valeur de hachage.
+ */
+uint32_t karpRabinHash(char* s, int length) {
+    uint32_t h = 0;
+    for (int i = 0; i < length; i++) {
+        h = h * KARP_RABIN_BASE + (unsigned char) s[i];
+    }
+    return h;
+}
+
+/**
+ * Fonction qui calcule le poids du premier caractère d'une fenêtre de
+ * longueur length, KARP_RABIN_BASE^(length - 1) modulo 2^32, utilisé pour
+ * le retirer du hachage lors du glissement.
+ *
+ * @param length longueur de la fenêtre.
+ * @return le poids du premier caractère.
+ */
+uint32_t karpRabinPower(int length) {
+    uint32_t power = 1;
+    for (int i = 1; i < length; i++) {
+        power *= KARP_RABIN_BASE;
+    }
+    return power;
+}
+
+/**
+ * Fonction qui fait glisser la fenêtre de hachage d'un caractère : retire
+ * out (premier caractère de l'ancienne fenêtre) et ajoute in à la fin.
+ *
+ * @param h valeur de hachage de l'ancienne fenêtre.
+ * @param out caractère qui sort de la fenêtre.
+ * @param in caractère qui entre dans la fenêtre.
+ * @param power poids du premier caractère (voir karpRabinPower()).
+ * @return la valeur de hachage de la nouvelle fenêtre.
+ */
+static inline uint32_t karpRabinRoll(uint32_t h, char out, char in, uint32_t power) {
+    return (h - (unsigned char) out * power) * KARP_RABIN_BASE + (unsigned char) in;
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme de Karp-Rabin.
+ * Le hachage de la fenêtre i + 1 vaut H(i) * KARP_RABIN_BASE + d(i), avec
+ * d(i) = text[i + wordLength] - text[i] * KARP_RABIN_BASE^wordLength : les
+ * d(i) ne dépendent pas les uns des autres. Les fenêtres sont traitées par
+ * blocs de KARP_RABIN_BLOCK : les d(i) du bloc sont calculés d'un coup
+ * (vectorisés), puis les hachages de KARP_RABIN_STEP fenêtres consécutives
+ * sont tous déduits du même hachage précédent. La chaîne de dépendances ne
+ * compte plus qu'une multiplication et une addition toutes les
+ * KARP_RABIN_STEP fenêtres, au lieu d'une par fenêtre. Les fenêtres de la
+ * fin du texte glissent une à une. Une fenêtre de même valeur que le mot est
+ * vérifiée par memcmp().
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long karpRabinOccurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+    // Mot plus long que le texte : aucune occurrence.
+    if (wordLength > textLength) {
+        return 0;
+    }
+
+    const unsigned char* t = (const unsigned char*) text;
+    // powers[r] = KARP_RABIN_BASE^r.
+    uint32_t powers[KARP_RABIN_STEP + 1];
+    powers[0] = 1;
+    for (int r = 1; r <= KARP_RABIN_STEP; r++) {
+        powers[r] = powers[r - 1] * KARP_RABIN_BASE;
+    }
+    uint32_t power = karpRabinPower(wordLength);
+    uint32_t shift = power * KARP_RABIN_BASE;
+    uint32_t wordHash = karpRabinHash(word, wordLength);
+    uint32_t h = karpRabinHash(text, wordLength);
+    ptrdiff_t last = textLength - wordLength;
+
+    long long count = 0;
+    if (h == wordHash && memcmp(word, text, (size_t) wordLength) == 0) {
+        count++;
+        if (report != NULL && report(0, data) != 0) {
+            return count;
+        }
+    }
+    // Fenêtres i + 1 à i + KARP_RABIN_BLOCK.
+    ptrdiff_t i = 0;
+    for (; i + KARP_RABIN_BLOCK <= last; i += KARP_RABIN_BLOCK) {
+        uint32_t hashes[KARP_RABIN_BLOCK];
+        for (int j = 0; j < KARP_RABIN_BLOCK; j++) {
+            hashes[j] = (uint32_t) t[i + wordLength + j] - (uint32_t) t[i + j] * shift;
+        }
+        uint32_t found = 0;
+        for (int g = 0; g < KARP_RABIN_BLOCK; g += KARP_RABIN_STEP) {
+            // Somme des d(i) du groupe, puis ajout du hachage précédent.
+            uint32_t sum = 0;
+            for (int j = g; j < g + KARP_RABIN_STEP; j++) {
+                sum = sum * KARP_RABIN_BASE + hashes[j];
+                hashes[j] = sum;
+            }
+            for (int r = 0; r < KARP_RABIN_STEP; r++) {
+                hashes[g + r] += h * powers[r + 1];
+                found |= hashes[g + r] == wordHash;
+            }
+            h = hashes[g + KARP_RABIN_STEP - 1];
+        }
+        for (int j = 0; found && j < KARP_RABIN_BLOCK; j++) {
+            if (hashes[j] == wordHash && memcmp(word, text + i + 1 + j, (size_t) wordLength) == 0) {
+                count++;
+                if (report != NULL && report(i + 1 + j, data) != 0) {
+                    return count;
+                }
+            }
+        }
+    }
+    // Dernières fenêtres, une à une.
+    for (; i < last; i++) {
+        h = karpRabinRoll(h, text[i], text[i + wordLength], power);
+        if (h == wordHash && memcmp(word, text + i + 1, (size_t) wordLength) == 0) {
+            count++;
+            if (report != NULL && report(i + 1, data) != 0) {
+                return count;
+            }
+        }
+    }
+
+    return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Recherche multi-motifs (mots de même longueur)
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Type des fonctions appelées pour chaque occurrence trouvée par une
+ * recherche multi-motifs.
+ * Renvoie 0 pour continuer la recherche, une autre valeur pour l'arrêter.
+ *
+ * @param wordIndex indice, dans la liste, du mot trouvé.
+ * @param index indice du premier caractère de l'occurrence dans le texte.
+ * @param data donnée transmise par l'appelant.
+ */
+typedef int (*multiOccurrenceCallback)(int wordIndex, ptrdiff_t index, void* data);
+
+/**
+ * Fonction qui calcule la case d'une valeur de hachage dans une table de
+ * 2^bits cases. Les bits de poids fort du produit par une constante impaire
+ * sont bien mélangés, contrairement aux bits de poids faible du hachage de
+ * Karp-Rabin (257 vaut 1 modulo 256).
+ *
+ * @param h valeur de hachage.
+ * @param bits logarithme en base 2 de la taille de la table (au moins 1).
+ * @return l'indice de la case.
+ */
+static inline uint32_t patternSlot(uint32_t h, int bits) {
+    return (h * 2654435761u) >> (32 - bits);
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'une liste de mots de même
+ * longueur dans un texte, en une seule passe.
+ * Les valeurs de hachage de Karp-Rabin des mots sont rangées dans une table
+ * à adressage ouvert. La fenêtre de longueur wordLength glisse sur le texte
+ * comme dans karpRabinOccurrences(), et sa valeur est cherchée dans la table ;
+ * chaque candidat est vérifié par memcmp(). Le texte est lu une seule fois,
+ * quel que soit le nombre de mots.
+ * Le débit reste de 75 à 160 Mo/s quelle que soit la taille de la liste,
+ * contre 500 à 2800 Mo/s pour une passe de Horspool (environ 130 contre
+ * 1600 Mo/s pour un seul mot). Mesures de demo sur un texte de 10^6
+ * caractères : Horspool répété reste plus rapide jusqu'à 4 mots sur 4
+ * lettres, jusqu'à 16 mots sur 20 ou 70 lettres (32 pour des mots de 20
+ * caractères). En dessous de MULTI_KARP_RABIN_MIN_WORDS mots
+ * (MULTI_KARP_RABIN_MIN_WORDS_SMALL_ALPHABET sur 4 lettres ou moins), il vaut
+ * mieux rechercher chaque mot séparément : searchWordList() de search.h fait
+ * ce choix.
+ * Les occurrences sont transmises dans l'ordre croissant des indices du
+ * texte.
+ *
+ * @param text texte dans lequel rechercher les mots.
+ * @param textLength longueur du texte.
+ * @param words liste des mots à rechercher.
+ * @param wordCount nombre de mots de la liste.
+ * @param wordLength longueur commune des mots.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre total d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long multiKarpRabinOccurrences(char* text, ptrdiff_t textLength, char** words, int wordCount, int wordLength, multiOccurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou la liste est NULL, on renvoie -2.
+    if (text == NULL || words == NULL || wordCount <= 0 || wordLength <= 0) {
+        return -2;
+    }
+    // Mots plus longs que le texte : aucune occurrence.
+    if (wordLength > textLength) {
+        return 0;
+    }
+
+    // Table d'au moins 2 * wordCount cases (taux de remplissage <= 1/2).
+    int bits = 1;
+    while ((1 << bits) < 2 * wordCount) {
+        bits++;
+    }
+    int size = 1 << bits;
+    uint32_t* slotHash = malloc((sizeof(uint32_t) + sizeof(int)) * (size_t) size);
+    // Test d'erreur. Si l'allocation a échoué, on renvoie -2.
+    if (slotHash == NULL) {
+        perror("malloc");
+        return -2;
+    }
+    int* slotWord = (int*) (slotHash + size);
+    for (int k = 0; k < size; k++) {
+        slotWord[k] = -1;
+    }
+
+    // Insertion des mots (sondage linéaire).
+    for (int w = 0; w < wordCount; w++) {
+        // Test d'erreur. Si un mot est NULL, on renvoie -2.
+        if (words[w] == NULL) {
+            free(slotHash);
+            return -2;
+        }
+        uint32_t h = karpRabinHash(words[w], wordLength);
+        uint32_t slot = patternSlot(h, bits);
+        while (slotWord[slot] != -1) {
+            slot = (slot + 1) & (uint32_t) (size - 1);
+        }
+        slotHash[slot] = h;
+        slotWord[slot] = w;
+    }
+
+    uint32_t power = karpRabinPower(wordLength);
+    uint32_t h = karpRabinHash(text, wordLength);
+    long long count = 0;
+    for (ptrdiff_t i = 0;; i++) {
+        // Recherche de la fenêtre dans la table.
+        uint32_t slot = patternSlot(h, bits);
+        while (slotWord[slot] != -1) {
+            int w = slotWord[slot];
+            if (slotHash[slot] == h && memcmp(words[w], text + i, (size_t) wordLength) == 0) {
+                count++;
+                if (report != NULL && report(w, i, data) != 0) {
+                    free(slotHash);
+                    return count;
+                }
+            }
+            slot = (slot + 1) & (uint32_t) (size - 1);
+        }
+        if (i == textLength - wordLength) {
+            break;
+        }
+        h = karpRabinRoll(h, text[i], text[i + wordLength], power);
+    }
+
+    free(slotHash);
+    return count;
+}
+
+/**
+ * Fonction qui calcule la valeur d'un bloc de blockLength caractères (1 à 3)
+ * pour les tables de Wu-Manber : exacte pour 1 ou 2 caractères, hachée sur
+ * 16 bits pour 3.
+ *
+ * @param block premier caractère du bloc.
+ * @param blockLength longueur du bloc.
+ * @return la valeur du bloc, inférieure à WU_MANBER_TABLE_SIZE.
+ */
+static inline int wuManberBlock(char* block, int blockLength) {
+    unsigned char* b = (unsigned char*) block;
+    if (blockLength == 1) {
+        return b[0];
+    }
+    if (blockLength == 2) {
+        return (b[0] << 8) | b[1];
+    }
+    return ((b[0] << 10) ^ (b[1] << 5) ^ b[2]) & (WU_MANBER_TABLE_SIZE - 1);
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'une liste de mots de
+ * longueurs quelconques dans un texte, en utilisant l'algorithme de
+ * Wu-Manber.
+ * Soit m la longueur du plus court mot. Seuls les m premiers caractères de
+ * chaque mot servent au filtrage. La fenêtre de longueur m est décalée selon
+ * la table des décalages, indexée par son dernier bloc de 2 caractères (3
+ * pour les grandes listes de mots longs, 1 si m = 1). Quand le décalage est
+ * nul, les mots dont le préfixe se termine par ce bloc sont filtrés par
+ * leurs deux premiers caractères, puis vérifiés par memcmp().
+ * Les occurrences sont transmises dans l'ordre croissant des indices du
+ * texte.
+ *
+ * @param text texte dans lequel rechercher les mots.
+ * @param textLength longueur du texte.
+ * @param words liste des mots à rechercher.
+ * @param wordLengths longueurs des mots.
+ * @param wordCount nombre de mots de la liste.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre total d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long wuManberOccurrences(char* text, ptrdiff_t textLength, char** words, int* wordLengths, int wordCount, multiOccurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou la liste est NULL, on renvoie -2.
+    if (text == NULL || words == NULL || wordLengths == NULL || wordCount <= 0) {
+        return -2;
+    }
+    // Longueur du plus court mot.
+    int m = wordLengths[0];
+    for (int w = 0; w < wordCount; w++) {
+        // Test d'erreur. Si un mot est NULL ou vide, on renvoie -2.
+        if (words[w] == NULL || wordLengths[w] <= 0) {
+            return -2;
+        }
+        m = wordLengths[w] < m ? wordLengths[w] : m;
+    }
+    // Taille des blocs.
+    int blockLength = m == 1 ? 1 : (m >= 6 && wordCount >= 128 ? 3 : 2);
+
+    // Allocation de la table des décalages, des débuts de paquets (un paquet
+    // par valeur de bloc), et des mots rangés par paquet.
+    int* shiftTable = malloc(sizeof(int) * ((size_t) 2 * WU_MANBER_TABLE_SIZE + 1 + (size_t) wordCount));
+    // Test d'erreur. Si l'allocation a échoué, on renvoie -2.
+    if (shiftTable == NULL) {
+        perror("malloc");
+        return -2;
+    }
+    int* bucketStart = shiftTable + WU_MANBER_TABLE_SIZE;
+    int* bucketWords = bucketStart + WU_MANBER_TABLE_SIZE + 1;
+
+    // Table des décalages : distance entre la dernière occurrence d'un bloc
+    // dans les préfixes de longueur m et la fin de la fenêtre.
+    for (int h = 0; h < WU_MANBER_TABLE_SIZE; h++) {
+        shiftTable[h] = m - blockLength + 1;
+        bucketStart[h] = 0;
+    }
+    bucketStart[WU_MANBER_TABLE_SIZE] = 0;
+    for (int w = 0; w < wordCount; w++) {
+        for (int q = blockLength; q <= m; q++) {
+            int h = wuManberBlock(words[w] + q - blockLength, blockLength);
+            if (m - q < shiftTable[h]) {
+                shiftTable[h] = m - q;
+            }
+        }
+        // Comptage des mots par valeur du dernier bloc du préfixe.
+        bucketStart[wuManberBlock(words[w] + m - blockLength, blockLength) + 1]++;
+    }
+    // Répartition des mots dans les paquets (tri par comptage).
+    for (int h = 0; h < WU_MANBER_TABLE_SIZE; h++) {
+        bucketStart[h + 1] += bucketStart[h];
+    }
+    for (int w = 0; w < wordCount; w++) {
+        int h = wuManberBlock(words[w] + m - blockLength, blockLength);
+        bucketWords[bucketStart[h]++] = w;
+    }
+    // bucketStart[h] est maintenant la fin du paquet h, et le début du paquet
+    // h + 1 : on décale d'un cran.
+    for (int h = WU_MANBER_TABLE_SIZE; h > 0; h--) {
+        bucketStart[h] = bucketStart[h - 1];
+    }
+    bucketStart[0] = 0;
+
+    long long count = 0;
+    // pos : indice du dernier caractère de la fenêtre.
+    ptrdiff_t pos = m - 1;
+    while (pos < textLength) {
+        int h = wuManberBlock(text + pos - blockLength + 1, blockLength);
+        int shift = shiftTable[h];
+        if (shift > 0) {
+            pos += shift;
+            continue;
+        }
+        // Vérification des mots candidats.
+        ptrdiff_t start = pos - m + 1;
+        for (int k = bucketStart[h]; k < bucketStart[h + 1]; k++) {
+            int w = bucketWords[k];
+            // Filtre sur les deux premiers caractères, puis vérification.
+            if (words[w][0] != text[start] || (m > 1 && words[w][1] != text[start + 1])) {
+                continue;
+            }
+            if (start + wordLengths[w] <= textLength && memcmp(words[w], text + start, (size_t) wordLengths[w]) == 0) {
+                count++;
+                if (report != NULL && report(w, start, data) != 0) {
+                    free(shiftTable);
+                    return count;
+                }
+            }
+        }
+        pos += 1;
+    }
+
+    free(shiftTable);
+    return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Quick Search, Raita et Horspool optimisé
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme Quick Search de Sunday.
+ * Le décalage est donné par le caractère qui suit immédiatement la fenêtre,
+ * ce qui permet des décalages de wordLength + 1. La fenêtre est comparée de
+ * gauche à droite par memcmp().
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long quickSearchOccurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+
+    // Table des décalages : wordLength - i pour la dernière occurrence i de
+    // chaque lettre, wordLength + 1 pour les lettres absentes du mot.
+    int shift[256];
+    for (int c = 0; c < 256; c++) {
+        shift[c] = wordLength + 1;
+    }
+    for (int i = 0; i < wordLength; i++) {
+        shift[(unsigned char) word[i]] = wordLength - i;
+    }
+
+    long long count = 0;
+    ptrdiff_t i = 0;
+    while (i <= textLength - wordLength) {
+        if (memcmp(word, text + i, (size_t) wordLength) == 0) {
+            count++;
+            if (report != NULL && report(i, data) != 0) {
+                return count;
+            }
+        }
+        // Pas de caractère après la dernière fenêtre.
+        if (i + wordLength >= textLength) {
+            break;
+        }
+        i += shift[(unsigned char) text[i + wordLength]];
+    }
+
+    return count;
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme de Raita.
+ * Même décalage que Horspool, mais la fenêtre est comparée d'abord sur le
+ * dernier caractère, puis le premier, puis celui du milieu, et enfin sur le
+ * reste par memcmp().
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long raitaOccurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+
+    int dernOcc[256];
+    dernOccTable(word, wordLength, dernOcc);
+    char first = word[0];
+    char middle = word[wordLength / 2];
+    char last = word[wordLength - 1];
+    size_t rest = wordLength > 2 ? (size_t) (wordLength - 2) : 0;
+
+    long long count = 0;
+    ptrdiff_t i = 0;
+    while (i <= textLength - wordLength) {
+        char c = text[i + wordLength - 1];
+        if (c == last && text[i] == first && text[i + wordLength / 2] == middle && memcmp(word + 1, text + i + 1, rest) == 0) {
+            count++;
+            if (report != NULL && report(i, data) != 0) {
+                return count;
+            }
+        }
+        i += dernOcc[(unsigned char) c];
+    }
+
+    return count;
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, en
+ * utilisant l'algorithme de Horspool optimisé (Tuned Boyer-Moore de Hume et
+ * Sunday).
+ * Dans la table des décalages, la dernière lettre du mot a un décalage nul :
+ * elle sert de sentinelle, et la boucle de saut, déroulée trois fois, ne fait
+ * que des lectures de la table jusqu'à tomber sur cette lettre. Le mot n'est
+ * alors comparé qu'à ce moment, par memcmp(), puis la fenêtre avance du
+ * décalage de Horspool de la dernière lettre.
+ * La boucle déroulée ne s'exécute que si trois décalages (au plus
+ * wordLength chacun) restent dans le texte ; la fin du texte est traitée
+ * pas à pas. Le texte n'est jamais modifié.
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long horspoolOptimiseOccurrences(char* text, char* word, ptrdiff_t textLength, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+    // Mot plus long que le texte : aucune occurrence.
+    if (wordLength > textLength) {
+        return 0;
+    }
+
+    // Table de Horspool, avec un décalage nul pour la dernière lettre.
+    int skip[256];
+    dernOccTable(word, wordLength, skip);
+    unsigned char last = (unsigned char) word[wordLength - 1];
+    int lastShift = skip[last];
+    skip[last] = 0;
+
+    // Tant que i < limit, trois décalages restent dans le texte.
+    ptrdiff_t limit = textLength - 3 * wordLength;
+    long long count = 0;
+    // i : indice du dernier caractère de la fenêtre.
+    ptrdiff_t i = wordLength - 1;
+    while (1) {
+        int k = skip[(unsigned char) text[i]];
+        // Boucle de saut déroulée.
+        while (k != 0 && i < limit) {
+            i += k;
+            k = skip[(unsigned char) text[i]];
+            i += k;
+            k = skip[(unsigned char) text[i]];
+            i += k;
+            k = skip[(unsigned char) text[i]];
+        }
+        // Fin du texte, pas à pas.
+        while (k != 0) {
+            i += k;
+            if (i >= textLength) {
+                return count;
+            }
+            k = skip[(unsigned char) text[i]];
+        }
+        // La dernière lettre correspond : on compare le reste du mot.
+        if (memcmp(word, text + i - wordLength + 1, (size_t) (wordLength - 1)) == 0) {
+            count++;
+            if (report != NULL && report(i - wordLength + 1, data) != 0) {
+                return count;
+            }
+        }
+        i += lastShift;
+        if (i >= textLength) {
+            return count;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Motifs compilés
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Motif compilé : le mot et toutes ses tables de prétraitement, calculées une
+ * fois par compilePattern() dans une seule allocation alignée sur
+ * PATTERN_ALIGNMENT octets. Le motif n'est plus modifié ensuite : il peut
+ * servir pour autant de textes que voulu, et depuis plusieurs threads à la
+ * fois. Il est libéré par freePattern().
+ */
+struct compiledPattern {
+    // Mot (copie terminée par '\0') et sa longueur.
+    char* word;
+    int wordLength;
+    // Table dernOcc (256 cases), pour Boyer-Moore, Horspool, Turbo-BM et
+    // Apostolico-Giancarlo.
+    int* dernOcc;
+    // Tables bonPref et meilPref (wordLength + 1 cases), pour MP et KMP.
+    int* bonPref;
+    int* meilPref;
+    // Tables Suff et BonSuff (wordLength cases), pour la famille Boyer-Moore.
+    int* suff;
+    int* bonSuff;
+};
+
+/**
+ * Fonction qui compile un mot : copie le mot et calcule toutes ses tables
+ * (dernOcc, bonPref, meilPref, Suff, BonSuff) dans une seule allocation
+ * alignée.
+ *
+ * @param word mot à compiler.
+ * @param wordLength longueur du mot.
+ * @return le motif compilé, ou NULL en cas d'erreur.
+ */
+struct compiledPattern* compilePattern(char* word, int wordLength) {
+    // Test d'erreur. Si le mot est NULL ou vide, on renvoie NULL.
+    if (word == NULL || wordLength <= 0) {
+        return NULL;
+    }
+
+    // Taille de l'allocation : en-tête, tables (de la plus utilisée à la
+    // moins utilisée), puis le mot, arrondie à un multiple de l'alignement.
+    size_t m = (size_t) wordLength;
+    size_t header = (sizeof(struct compiledPattern) + PATTERN_ALIGNMENT - 1) / PATTERN_ALIGNMENT * PATTERN_ALIGNMENT;
+    size_t size = header + sizeof(int) * (256 + 2 * (m + 1) + 2 * m) + m + 1;
+    size = (size + PATTERN_ALIGNMENT - 1) / PATTERN_ALIGNMENT * PATTERN_ALIGNMENT;
+    char* block = aligned_alloc(PATTERN_ALIGNMENT, size);
+    // Test d'erreur. Si l'allocation a échoué, on renvoie NULL.
+    if (block == NULL) {
+        perror("aligned_alloc");
+        return NULL;
+    }
+
+    // Découpage de l'allocation.
+    struct compiledPattern* pattern = (struct compiledPattern*) block;
+    pattern->wordLength = wordLength;
+    pattern->dernOcc = (int*) (block + header);
+    pattern->bonPref = pattern->dernOcc + 256;
+    pattern->meilPref = pattern->bonPref + m + 1;
+    pattern->suff = pattern->meilPref + m + 1;
+    pattern->bonSuff = pattern->suff + m;
+    pattern->word = (char*) (pattern->bonSuff + m);
+    memcpy(pattern->word, word, m);
+    pattern->word[m] = '\0';
+
+    // Calcul des tables.
+    dernOccTable(pattern->word, wordLength, pattern->dernOcc);
+    bonPrefTable(pattern->word, wordLength, pattern->bonPref);
+    meilPrefTable(pattern->word, wordLength, pattern->meilPref);
+    bonSuffTable(pattern->word, wordLength, pattern->suff, pattern->bonSuff);
+
+    return pattern;
+}
+
+/**
+ * Fonction qui libère un motif compilé par compilePattern().
+ *
+ * @param pattern motif à libérer (ou NULL).
+ */
+void freePattern(struct compiledPattern* pattern) {
+    free(pattern);
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un motif compilé dans un
+ * texte, avec l'un des algorithmes à tables précalculées : 7 (Morris-Pratt),
+ * 8 (Knuth-Morris-Pratt), 9 (Boyer-Moore), 10 (Horspool), 16 (Turbo-BM) ou
+ * 17 (Apostolico-Giancarlo).
+ *
+ * @param pattern motif compilé.
+ * @param algoNum numéro de l'algorithme.
+ * @param text texte dans lequel rechercher le motif.
+ * @param textLength longueur du texte.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur (motif
+ *         NULL ou algorithme inconnu).
+ */
+long long compiledOccurrences(struct compiledPattern* pattern, int algoNum, char* text, ptrdiff_t textLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le motif est NULL, on renvoie -2.
+    if (pattern == NULL) {
+        return -2;
+    }
+    char* word = pattern->word;
+    int m = pattern->wordLength;
+    switch (algoNum) {
+        case 7:
+            return morrisPrattOccurrences(text, word, textLength, m, pattern->bonPref, report, data);
+        case 8:
+            return knuthMorrisPrattOccurrences(text, word, textLength, m, pattern->meilPref, report, data);
+        case 9:
+            return boyerMooreOccurrences(text, textLength, word, m, pattern->bonSuff, pattern->dernOcc, report, data);
+        case 10:
+            return horspoolOccurrences(text, textLength, word, m, pattern->dernOcc, report, data);
+        case 16:
+            return turboBoyerMooreOccurrences(text, textLength, word, m, pattern->bonSuff, pattern->dernOcc, report, data);
+        case 17:
+            return apostolicoGiancarloOccurrences(text, textLength, word, m, pattern->suff, pattern->bonSuff, pattern->dernOcc, report, data);
+        default:
+            return -2;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Versions comptage seul
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Versions "Count" des fonctions "Occurrences" ci-dessus, dans le même ordre :
+ * xCount() prend les paramètres de xOccurrences() sans report ni data, et
+ * renvoie la même valeur. Sauf shiftOrCount(), chacune appelle
+ * xOccurrences() avec report = NULL (l'attribut flatten y développe la
+ * recherche) : elles donnent une interface uniforme, pas un gain de temps.
+ * Les mesures de compareCountReport() (demo.c) donnent des temps égaux aux
+ * écarts de mesure près, dans un sens comme dans l'autre.
+ */
+
+__attribute__((flatten))
+long long naifCount(char* text, char* word, ptrdiff_t textLength, int wordLength) {
+    return naifOccurrences(text, word, textLength, wordLength, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long naifBoucleRapideCount(char* text, char* word, ptrdiff_t textLength, int wordLength) {
+    return naifBoucleRapideOccurrences(text, word, textLength, wordLength, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long naifSentinelleCount(char* text, char* word, ptrdiff_t textLength, int wordLength) {
+    return naifSentinelleOccurrences(text, word, textLength, wordLength, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long naifStrncmpCount(char* text, char* word, ptrdiff_t textLength, int wordLength) {
+    return naifStrncmpOccurrences(text, word, textLength, wordLength, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long naifRapideStrncmpCount(char* text, char* word, ptrdiff_t textLength, int wordLength) {
+    return naifRapideStrncmpOccurrences(text, word, textLength, wordLength, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long naifSentinelleStrncmpCount(char* text, char* word, ptrdiff_t textLength, int wordLength) {
+    return naifSentinelleStrncmpOccurrences(text, word, textLength, wordLength, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long morrisPrattCount(char* text, char* word, ptrdiff_t textLength, int wordLength, int* bonPref) {
+    return morrisPrattOccurrences(text, word, textLength, wordLength, bonPref, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long knuthMorrisPrattCount(char* text, char* word, ptrdiff_t textLength, int wordLength, int* meilPref) {
+    return knuthMorrisPrattOccurrences(text, word, textLength, wordLength, meilPref, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long boyerMooreCount(char* text, ptrdiff_t textLength, char* word, int wordLength, int* bonSuff, int* dernOcc) {
+    return boyerMooreOccurrences(text, textLength, word, wordLength, bonSuff, dernOcc, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long horspoolCount(char* text, ptrdiff_t textLength, char* word, int wordLength, int* dernOcc) {
+    return horspoolOccurrences(text, textLength, word, wordLength, dernOcc, NULL, NULL);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("sse2"), flatten))
+long long naifSse2Count(char* text, char* word, ptrdiff_t textLength, int wordLength) {
+    return naifSse2Occurrences(text, word, textLength, wordLength, NULL, NULL);
+}
+
+__attribute__((target("avx2"), flatten))
+long long naifAvx2Count(char* text, char* word, ptrdiff_t textLength, int wordLength) {
+    return naifAvx2Occurrences(text, word, textLength, wordLength, NULL, NULL);
+}
+#endif
+
+/**
+ * Choix du noyau comme dans naifSimdOccurrences() : AVX2, SSE2 ou boucle
+ * scalaire.
+ */
+long long naifSimdCount(char* text, char* word, ptrdiff_t textLength, int wordLength) {
+    // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    if (__builtin_cpu_supports("avx2")) {
+        return naifAvx2Count(text, word, textLength, wordLength);
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return naifSse2Count(text, word, textLength, wordLength);
+    }
+#endif
+    return naifQueueOccurrences(text, word, textLength, wordLength, 0, 0, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long twoWayCount(char* text, char* word, ptrdiff_t textLength, int wordLength) {
+    return twoWayOccurrences(text, word, textLength, wordLength, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long shiftOrMultiCount(char* text, char* word, ptrdiff_t textLength, int wordLength) {
+    return shiftOrMultiOccurrences(text, word, textLength, wordLength, NULL, NULL);
+}
+
+/**
+ * Version comptage seul de Shift-Or, avec sa propre boucle. Le texte est lu
+ * par blocs de 8 caractères : les états du bloc sont combinés par un ET, dont
+ * le bit de fin ne vaut 0 que si une occurrence se termine dans le bloc. Un
+ * seul test par bloc au lieu d'un par caractère ; les blocs rares qui
+ * contiennent une occurrence sont recomptés caractère par caractère.
+ */
+long long shiftOrCount(char* text, char* word, ptrdiff_t textLength, int wordLength) {
+    // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+    // Mot trop long pour un seul mot machine.
+    if (wordLength > 64) {
+        return shiftOrMultiOccurrences(text, word, textLength, wordLength, NULL, NULL);
+    }
+
+    uint64_t masks[256];
+    for (int c = 0; c < 256; c++) {
+        masks[c] = ~(uint64_t) 0;
+    }
+    for (int i = 0; i < wordLength; i++) {
+        masks[(unsigned char) word[i]] &= ~((uint64_t) 1 << i);
+    }
+    uint64_t lastBit = (uint64_t) 1 << (wordLength - 1);
+    const unsigned char* t = (const unsigned char*) text;
+
+    long long count = 0;
+    uint64_t state = ~(uint64_t) 0;
+    ptrdiff_t j = 0;
+    for (; j + 8 <= textLength; j += 8) {
+        uint64_t start = state;
+        uint64_t all = ~(uint64_t) 0;
+        for (int k = 0; k < 8; k++) {
+            state = (state << 1) | masks[t[j + k]];
+            all &= state;
+        }
+        // Occurrence dans le bloc : on le recompte.
+        if ((all & lastBit) == 0) {
+            state = start;
+            for (int k = 0; k < 8; k++) {
+                state = (state << 1) | masks[t[j + k]];
+                count += (state & lastBit) == 0;
+            }
+        }
+    }
+    for (; j < textLength; j++) {
+        state = (state << 1) | masks[t[j]];
+        count += (state & lastBit) == 0;
+    }
+
+    return count;
+}
+
+__attribute__((flatten))
+long long bndmCount(char* text, char* word, ptrdiff_t textLength, int wordLength) {
+    return bndmOccurrences(text, word, textLength, wordLength, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long bomCount(char* text, char* word, ptrdiff_t textLength, int wordLength) {
+    return bomOccurrences(text, word, textLength, wordLength, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long turboBoyerMooreCount(char* text, ptrdiff_t textLength, char* word, int wordLength, int* bonSuff, int* dernOcc) {
+    return turboBoyerMooreOccurrences(text, textLength, word, wordLength, bonSuff, dernOcc, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long apostolicoGiancarloCount(char* text, ptrdiff_t textLength, char* word, int wordLength, int* suff, int* bonSuff, int* dernOcc) {
+    return apostolicoGiancarloOccurrences(text, textLength, word, wordLength, suff, bonSuff, dernOcc, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long karpRabinCount(char* text, char* word, ptrdiff_t textLength, int wordLength) {
+    return karpRabinOccurrences(text, word, textLength, wordLength, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long multiKarpRabinCount(char* text, ptrdiff_t textLength, char** words, int wordCount, int wordLength) {
+    return multiKarpRabinOccurrences(text, textLength, words, wordCount, wordLength, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long wuManberCount(char* text, ptrdiff_t textLength, char** words, int* wordLengths, int wordCount) {
+    return wuManberOccurrences(text, textLength, words, wordLengths, wordCount, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long quickSearchCount(char* text, char* word, ptrdiff_t textLength, int wordLength) {
+    return quickSearchOccurrences(text, word, textLength, wordLength, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long raitaCount(char* text, char* word, ptrdiff_t textLength, int wordLength) {
+    return raitaOccurrences(text, word, textLength, wordLength, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long horspoolOptimiseCount(char* text, char* word, ptrdiff_t textLength, int wordLength) {
+    return horspoolOptimiseOccurrences(text, word, textLength, wordLength, NULL, NULL);
+}
+
+__attribute__((flatten))
+long long compiledCount(struct compiledPattern* pattern, int algoNum, char* text, ptrdiff_t textLength) {
+    return compiledOccurrences(pattern, algoNum, text, textLength, NULL, NULL);
+}
+
+#endif
@@ -0,0 +1,109 @@
+/**
+ * FICHIER:
+ * --------
+ * externalSA.c
+ *
+ * DESCRIPTION:
+ * ------------
+ * Programme de construction et d'interrogation d'un tableau des suffixes sur
+ * disque (voir externalSuffixArray.h), pour les textes plus grands que la
+ * mémoire.
+ *
+ * - build : construit le tableau des suffixes du texte dans un fichier, avec
+ *   un budget mémoire donné en Mo (fichiers temporaires dans tmpDir, par
+ *   défaut /tmp), et affiche le temps de construction.
+ * - count : projette le texte et le tableau, et affiche le nombre
+ *   d'occurrences de chaque mot.
+ *
+ * Exemple :
+ *   ./externalSA build texte.txt texte.sa 256
+ *   ./externalSA count texte.txt texte.sa motif1 motif2
+ *
+ * AUTEUR:
+ * -------
+ * M. TAIA
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+////////////////////////////////////////////////////////////////////////////////
+#include "externalSuffixArray.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Fonctions
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Fonction qui affiche l'usage du programme.
+ *
+ * @param name nom du programme.
+ */
+void printUsage(char* name) {
+    printf("Usage : %s build textFilename saFilename memoryMb [tmpDir]\n", name);
+    printf("        %s count textFilename saFilename word...\n", name);
+}
+
+/**
+ * Fonction principale.
+ *
+ * @param argc nombre d'arguments.
+ * @param argv arguments.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int main(int argc, char** argv) {
+    // Test du nombre d'arguments.
+    if (argc < 5) {
+        printUsage(argv[0]);
+        return -1;
+    }
+    char* textFilename = argv[2];
+    char* saFilename = argv[3];
+
+    if (strcmp(argv[1], "build") == 0 && argc <= 6) {
+        // Récupération des arguments.
+        long memoryMb = atol(argv[4]);
+        const char* tmpDir = argc == 6 ? argv[5] : "/tmp";
+        // Test des arguments
+        if (memoryMb <= 0) {
+            fprintf(stderr, "Le budget mémoire doit être strictement positif.\n");
+            return -1;
+        }
+        struct timespec start;
+        struct timespec end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        if (buildExternalSuffixArray(textFilename, saFilename, (size_t) memoryMb * 1024 * 1024, tmpDir) == -1) {
+            fprintf(stderr, "Erreur lors de la construction.\n");
+            return -1;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        printf("Tableau des suffixes construit en %f s.\n", (double) (end.tv_sec - start.tv_sec) + (double) (end.tv_nsec - start.tv_nsec) / 1e9);
+        return 0;
+    }
+
+    if (strcmp(argv[1], "count") == 0) {
+        struct externalSuffixArray index;
+        if (openExternalSuffixArray(textFilename, saFilename, &index) == -1) {
+            fprintf(stderr, "Erreur lors de la lecture du tableau des suffixes.\n");
+            return -1;
+        }
+        for (int i = 4; i < argc; i++) {
+            long long count = externalSuffixArrayCount(&index, argv[i], (int) strlen(argv[i]));
+            // Test d'erreur. Si la recherche a échoué, on renvoie -1.
+            if (count < 0) {
+                fprintf(stderr, "Erreur lors de la recherche de \"%s\".\n", argv[i]);
+                closeExternalSuffixArray(&index);
+                return -1;
+            }
+            printf("%s : %lld occurrences\n", argv[i], count);
+        }
+        closeExternalSuffixArray(&index);
+        return 0;
+    }
+
+    printUsage(argv[0]);
+    return -1;
+}
@@ -0,0 +1,1017 @@
+/**
+ * FICHIER:
+ * --------
+ * externalSuffixArray.h
+ *
+ * DESCRIPTION:
+ * ------------
+ * Ce fichier contient la construction sur disque du tableau des suffixes,
+ * pour les textes plus grands que la mémoire, et la recherche dans un tableau
+ * ainsi construit.
+ *
+ * Construction (buildExternalSuffixArray()), en lectures et écritures
+ * séquentielles, dans un budget mémoire donné :
+ * - le texte est lu par blocs consécutifs, chacun suivi des
+ *   EXTERNAL_KEY_LENGTH caractères suivants. Les suffixes de chaque bloc sont
+ *   triés par SA-IS (suffixArrayOf(), suffixArray.h) et écrits avec leur
+ *   clé, leurs EXTERNAL_KEY_LENGTH premiers caractères : chaque bloc est une
+ *   suite triée selon la clé ;
+ * - les suites sont fusionnées par passes, au plus EXTERNAL_MAX_FAN_IN à la
+ *   fois (tas de fusion). Toutes les suites d'une passe sont dans un seul
+ *   fichier temporaire, lu par des tampons qui se partagent le budget : le
+ *   nombre de fichiers ouverts ne dépend pas du nombre de blocs ;
+ * - si deux suffixes ont la même clé (facteur répété d'au moins
+ *   EXTERNAL_KEY_LENGTH caractères), l'ordre est terminé par doublement des
+ *   préfixes : le rang de chaque suffixe pour ses h premiers caractères et
+ *   celui du suffixe i + h donnent son rang pour 2h caractères. Chaque tour
+ *   est un parcours séquentiel des rangs dans l'ordre du texte, suivi de
+ *   deux tris externes.
+ *
+ * Le texte n'est jamais lu dans le désordre pendant la construction. Les
+ * fichiers temporaires sont créés dans tmpDir et supprimés dès leur
+ * ouverture : ils disparaissent à leur fermeture, même en cas d'erreur.
+ *
+ * Le fichier produit contient les positions des suffixes dans l'ordre, sur 8
+ * octets (int64_t, ordre des octets de la machine). Il est ensuite projeté
+ * en mémoire avec le texte par openExternalSuffixArray(), et les recherches
+ * ne lisent que les pages utiles (O(m log n) comparaisons de caractères).
+ *
+ * AUTEUR:
+ * -------
+ * M. TAIA
+ */
+
+#ifndef EXTERNAL_SUFFIX_ARRAY_H
+#define EXTERNAL_SUFFIX_ARRAY_H
+
+////////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+////////////////////////////////////////////////////////////////////////////////
+#include "exactSearchAlgos.h"
+#include "mappedText.h"
+#include "suffixArray.h"
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINES
+////////////////////////////////////////////////////////////////////////////////
+// Taille minimale des tampons de lecture et d'écriture.
+#define EXTERNAL_MIN_BUFFER 4096
+
+// Budget mémoire minimal de la construction.
+#define EXTERNAL_MIN_BUDGET (8 * EXTERNAL_MIN_BUFFER)
+
+// Nombre maximal de suites fusionnées à la fois.
+#define EXTERNAL_MAX_FAN_IN 64
+
+// Nombre de caractères de la clé de chaque suffixe, lus après la fin du bloc.
+#define EXTERNAL_KEY_LENGTH 16
+
+// Mémoire utilisée par caractère d'un bloc : le texte, le tableau de SA-IS
+// et ses types (arrondis à un octet).
+#define EXTERNAL_BLOCK_BYTES ((int64_t) sizeof(saIndex) + 2)
+
+////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Suffixe et sa clé : ses EXTERNAL_KEY_LENGTH premiers caractères, complétés
+ * par des octets nuls s'il est plus court.
+ */
+struct keyRecord {
+    int64_t pos; // Position du suffixe
+    int64_t keyLength; // Nombre de caractères de la clé
+    unsigned char key[EXTERNAL_KEY_LENGTH];
+};
+
+/**
+ * Enregistrement des tris du doublement des préfixes, trié selon (first,
+ * second) : (rang, rang du suffixe i + h, position) ou (position, 0, rang).
+ */
+struct rankRecord {
+    int64_t first;
+    int64_t second;
+    int64_t value;
+};
+
+/**
+ * Paramètres d'une construction, transmis à toutes ses étapes.
+ */
+struct externalBuild {
+    size_t memoryBudget; // Budget mémoire en octets
+    const char* tmpDir; // Répertoire des fichiers temporaires
+    int64_t n; // Longueur du texte
+};
+
+/**
+ * Suites triées d'enregistrements, écrites les unes après les autres dans un
+ * même fichier temporaire.
+ */
+struct runSet {
+    int fd; // Fichier des suites
+    int64_t* lengths; // Nombre d'enregistrements de chaque suite
+    int count; // Nombre de suites
+    int capacity; // Nombre de cases de lengths
+};
+
+/**
+ * Lecture tamponnée d'une suite, de offset à end (pread() : plusieurs
+ * lecteurs peuvent partager un fichier).
+ */
+struct runReader {
+    int fd;
+    off_t offset; // Prochain octet à lire dans le fichier
+    off_t end; // Fin de la suite dans le fichier
+    char* buffer;
+    size_t size; // Taille du tampon
+    size_t next; // Prochain octet à rendre dans le tampon
+    size_t fill; // Nombre d'octets du tampon
+};
+
+/**
+ * Écriture tamponnée et séquentielle dans un fichier.
+ */
+struct runWriter {
+    int fd;
+    char* buffer;
+    size_t size; // Taille du tampon
+    size_t fill; // Nombre d'octets du tampon
+};
+
+/**
+ * Tri externe : les enregistrements sont rangés dans un tampon, trié par
+ * qsort() et écrit comme une suite quand il est plein, puis les suites sont
+ * fusionnées.
+ */
+struct recordSorter {
+    struct externalBuild* build;
+    size_t recordSize;
+    int (*compare)(const void*, const void*);
+    char* records; // Tampon des enregistrements
+    size_t capacity; // Nombre d'enregistrements du tampon
+    size_t count; // Nombre d'enregistrements rangés
+    struct runWriter writer;
+    struct runSet runs;
+};
+
+/**
+ * Tableau des suffixes sur disque, projeté avec son texte par
+ * openExternalSuffixArray() et libéré par closeExternalSuffixArray().
+ */
+struct externalSuffixArray {
+    struct mappedText text;
+    struct mappedText array;
+    int64_t* sa; // Positions des suffixes (dans la projection de array)
+    ptrdiff_t length; // Longueur du texte
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Fonctions
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Fonction qui compare deux suffixes selon leur clé. Un suffixe plus court
+ * que la clé est plus petit que ceux dont il est préfixe. L'égalité signifie
+ * un préfixe commun d'au moins EXTERNAL_KEY_LENGTH caractères.
+ *
+ * @param a pointeur vers le premier struct keyRecord.
+ * @param b pointeur vers le deuxième struct keyRecord.
+ * @return un entier négatif, nul ou positif selon l'ordre des clés.
+ */
+int compareKeyRecords(const void* a, const void* b) {
+    const struct keyRecord* x = (const struct keyRecord*) a;
+    const struct keyRecord* y = (const struct keyRecord*) b;
+    int result = memcmp(x->key, y->key, EXTERNAL_KEY_LENGTH);
+    if (result != 0) {
+        return result;
+    }
+    return (x->keyLength > y->keyLength) - (x->keyLength < y->keyLength);
+}
+
+/**
+ * Fonction qui compare deux struct rankRecord selon (first, second).
+ *
+ * @param a pointeur vers le premier enregistrement.
+ * @param b pointeur vers le deuxième enregistrement.
+ * @return un entier négatif, nul ou positif selon l'ordre des couples.
+ */
+int compareRankRecords(const void* a, const void* b) {
+    const struct rankRecord* x = (const struct rankRecord*) a;
+    const struct rankRecord* y = (const struct rankRecord*) b;
+    if (x->first != y->first) {
+        return x->first < y->first ? -1 : 1;
+    }
+    return (x->second > y->second) - (x->second < y->second);
+}
+
+/**
+ * Fonction qui crée un fichier temporaire dans tmpDir, supprimé dès son
+ * ouverture.
+ *
+ * @param tmpDir répertoire des fichiers temporaires.
+ * @return le descripteur du fichier, ou -1 en cas d'erreur.
+ */
+int openTempFile(const char* tmpDir) {
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/saRunsXXXXXX", tmpDir);
+    int fd = mkstemp(path);
+    // Test d'erreur. Si la création a échoué, on renvoie -1.
+    if (fd == -1) {
+        perror(path);
+        return -1;
+    }
+    unlink(path);
+    return fd;
+}
+
+/**
+ * Fonction qui ajoute une suite (la suivante dans le fichier) à un ensemble
+ * de suites.
+ *
+ * @param runs ensemble de suites.
+ * @param length nombre d'enregistrements de la suite.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int appendRun(struct runSet* runs, int64_t length) {
+    if (runs->count == runs->capacity) {
+        int capacity = runs->capacity > 0 ? 2 * runs->capacity : 16;
+        int64_t* lengths = realloc(runs->lengths, sizeof(int64_t) * (size_t) capacity);
+        // Test d'erreur. Si l'allocation a échoué, on renvoie -1.
+        if (lengths == NULL) {
+            perror("realloc");
+            return -1;
+        }
+        runs->lengths = lengths;
+        runs->capacity = capacity;
+    }
+    runs->lengths[runs->count++] = length;
+    return 0;
+}
+
+/**
+ * Fonction qui ferme le fichier d'un ensemble de suites et libère ses
+ * longueurs.
+ *
+ * @param runs ensemble de suites.
+ */
+void closeRuns(struct runSet* runs) {
+    if (runs->fd != -1) {
+        close(runs->fd);
+    }
+    free(runs->lengths);
+    runs->fd = -1;
+    runs->lengths = NULL;
+    runs->count = 0;
+    runs->capacity = 0;
+}
+
+/**
+ * Fonction qui prépare l'écriture tamponnée dans un fichier.
+ *
+ * @param writer écriture à préparer.
+ * @param fd fichier (écrit à partir de sa position courante).
+ * @param size taille du tampon (au moins la taille d'un enregistrement).
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int initRunWriter(struct runWriter* writer, int fd, size_t size) {
+    writer->fd = fd;
+    writer->size = size;
+    writer->fill = 0;
+    writer->buffer = malloc(size);
+    // Test d'erreur. Si l'allocation a échoué, on renvoie -1.
+    if (writer->buffer == NULL) {
+        perror("malloc");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Fonction qui écrit le contenu du tampon dans le fichier.
+ *
+ * @param writer écriture tamponnée.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int flushRunWriter(struct runWriter* writer) {
+    size_t done = 0;
+    while (done < writer->fill) {
+        ssize_t written = write(writer->fd, writer->buffer + done, writer->fill - done);
+        // Test d'erreur. Si l'écriture a échoué, on renvoie -1.
+        if (written <= 0) {
+            perror("write");
+            return -1;
+        }
+        done += (size_t) written;
+    }
+    writer->fill = 0;
+    return 0;
+}
+
+/**
+ * Fonction qui écrit un enregistrement.
+ *
+ * @param writer écriture tamponnée.
+ * @param record enregistrement.
+ * @param recordSize taille de l'enregistrement.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int writeRecord(struct runWriter* writer, const void* record, size_t recordSize) {
+    if (writer->fill + recordSize > writer->size && flushRunWriter(writer) == -1) {
+        return -1;
+    }
+    memcpy(writer->buffer + writer->fill, record, recordSize);
+    writer->fill += recordSize;
+    return 0;
+}
+
+/**
+ * Fonction qui prépare la lecture tamponnée d'une suite.
+ *
+ * @param reader lecture à préparer.
+ * @param fd fichier de la suite.
+ * @param offset début de la suite dans le fichier.
+ * @param end fin de la suite dans le fichier.
+ * @param buffer tampon (fourni par l'appelant).
+ * @param size taille du tampon (au moins la taille d'un enregistrement).
+ */
+void initRunReader(struct runReader* reader, int fd, off_t offset, off_t end, char* buffer, size_t size) {
+    reader->fd = fd;
+    reader->offset = offset;
+    reader->end = end;
+    reader->buffer = buffer;
+    reader->size = size;
+    reader->next = 0;
+    reader->fill = 0;
+}
+
+/**
+ * Fonction qui lit l'enregistrement suivant d'une suite.
+ *
+ * @param reader lecture tamponnée.
+ * @param record enregistrement lu (résultat).
+ * @param recordSize taille de l'enregistrement.
+ * @return 1 si un enregistrement a été lu, 0 en fin de suite, -1 en cas
+ *         d'erreur.
+ */
+int readRecord(struct runReader* reader, void* record, size_t recordSize) {
+    if (reader->next + recordSize > reader->fill) {
+        if (reader->offset >= reader->end) {
+            return 0;
+        }
+        // Un nombre entier d'enregistrements par lecture.
+        size_t want = reader->size / recordSize * recordSize;
+        if ((off_t) want > reader->end - reader->offset) {
+            want = (size_t) (reader->end - reader->offset);
+        }
+        size_t got = 0;
+        while (got < want) {
+            ssize_t length = pread(reader->fd, reader->buffer + got, want - got, reader->offset + (off_t) got);
+            // Test d'erreur. Si la lecture a échoué, on renvoie -1.
+            if (length <= 0) {
+                perror("pread");
+                return -1;
+            }
+            got += (size_t) length;
+        }
+        reader->offset += (off_t) got;
+        reader->next = 0;
+        reader->fill = got;
+    }
+    memcpy(record, reader->buffer + reader->next, recordSize);
+    reader->next += recordSize;
+    return 1;
+}
+
+/**
+ * Fonction qui rétablit l'ordre du tas de fusion à partir de l'élément i
+ * (la suite dont l'enregistrement courant est le plus petit à la racine).
+ *
+ * @param heap tas de numéros de suites.
+ * @param size nombre d'éléments.
+ * @param i élément à descendre.
+ * @param heads enregistrement courant de chaque suite.
+ * @param recordSize taille d'un enregistrement.
+ * @param compare fonction de comparaison des enregistrements.
+ */
+void siftDownRuns(int* heap, int size, int i, const char* heads, size_t recordSize, int (*compare)(const void*, const void*)) {
+    for (;;) {
+        int smallest = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
+        if (left < size && compare(heads + (size_t) heap[left] * recordSize, heads + (size_t) heap[smallest] * recordSize) < 0) {
+            smallest = left;
+        }
+        if (right < size && compare(heads + (size_t) heap[right] * recordSize, heads + (size_t) heap[smallest] * recordSize) < 0) {
+            smallest = right;
+        }
+        if (smallest == i) {
+            return;
+        }
+        int swap = heap[i];
+        heap[i] = heap[smallest];
+        heap[smallest] = swap;
+        i = smallest;
+    }
+}
+
+/**
+ * Fonction qui fusionne les suites par passes, au plus fanIn à la fois,
+ * jusqu'à n'en avoir plus qu'une. Chaque passe écrit ses suites dans un
+ * nouveau fichier temporaire et ferme le précédent. Les tampons de lecture
+ * des fanIn suites et celui d'écriture se partagent le budget.
+ *
+ * @param runs suites à fusionner (remplacées par la suite fusionnée).
+ * @param recordSize taille d'un enregistrement.
+ * @param compare fonction de comparaison des enregistrements.
+ * @param build paramètres de la construction.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int mergeRuns(struct runSet* runs, size_t recordSize, int (*compare)(const void*, const void*), struct externalBuild* build) {
+    int maxFanIn = (int) (build->memoryBudget / EXTERNAL_MIN_BUFFER) - 1;
+    if (maxFanIn > EXTERNAL_MAX_FAN_IN) {
+        maxFanIn = EXTERNAL_MAX_FAN_IN;
+    }
+    while (runs->count > 1) {
+        int fanIn = runs->count < maxFanIn ? runs->count : maxFanIn;
+        size_t bufferSize = build->memoryBudget / (size_t) (fanIn + 1);
+        struct runSet next = {openTempFile(build->tmpDir), NULL, 0, 0};
+        struct runReader* readers = malloc(sizeof(struct runReader) * (size_t) fanIn);
+        char* buffers = malloc(bufferSize * (size_t) fanIn);
+        char* heads = malloc(recordSize * (size_t) fanIn);
+        int* heap = malloc(sizeof(int) * (size_t) fanIn);
+        struct runWriter writer = {-1, NULL, 0, 0};
+        int err = next.fd == -1 || readers == NULL || buffers == NULL || heads == NULL || heap == NULL
+                  || initRunWriter(&writer, next.fd, bufferSize) == -1;
+
+        // Fusion des suites first..first + fanIn - 1.
+        off_t offset = 0;
+        for (int first = 0; !err && first < runs->count; first += fanIn) {
+            int k = runs->count - first < fanIn ? runs->count - first : fanIn;
+            int64_t total = 0;
+            int heapSize = 0;
+            for (int r = 0; !err && r < k; r++) {
+                off_t end = offset + (off_t) runs->lengths[first + r] * (off_t) recordSize;
+                initRunReader(&readers[r], runs->fd, offset, end, buffers + (size_t) r * bufferSize, bufferSize);
+                offset = end;
+                total += runs->lengths[first + r];
+                int status = readRecord(&readers[r], heads + (size_t) r * recordSize, recordSize);
+                err = status == -1;
+                if (status == 1) {
+                    heap[heapSize++] = r;
+                }
+            }
+            for (int i = heapSize / 2 - 1; i >= 0; i--) {
+                siftDownRuns(heap, heapSize, i, heads, recordSize, compare);
+            }
+            while (!err && heapSize > 0) {
+                // Écriture du plus petit enregistrement, remplacé par le
+                // suivant de sa suite.
+                char* head = heads + (size_t) heap[0] * recordSize;
+                err = writeRecord(&writer, head, recordSize) == -1;
+                int status = err ? -1 : readRecord(&readers[heap[0]], head, recordSize);
+                err = status == -1;
+                if (status == 0) {
+                    heap[0] = heap[--heapSize];
+                }
+                siftDownRuns(heap, heapSize, 0, heads, recordSize, compare);
+            }
+            err = err || appendRun(&next, total) == -1;
+        }
+        err = err || flushRunWriter(&writer) == -1;
+
+        free(writer.buffer);
+        free(readers);
+        free(buffers);
+        free(heads);
+        free(heap);
+        closeRuns(runs);
+        *runs = next;
+        // Test d'erreur. Si la passe a échoué, on renvoie -1.
+        if (err) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Fonction qui prépare un tri externe, dans memory octets (tampon des
+ * enregistrements et tampon d'écriture des suites).
+ *
+ * @param sorter tri à préparer.
+ * @param build paramètres de la construction.
+ * @param recordSize taille d'un enregistrement.
+ * @param compare fonction de comparaison des enregistrements.
+ * @param memory mémoire du tri (au moins 2 * EXTERNAL_MIN_BUFFER).
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int initSorter(struct recordSorter* sorter, struct externalBuild* build, size_t recordSize, int (*compare)(const void*, const void*), size_t memory) {
+    sorter->build = build;
+    sorter->recordSize = recordSize;
+    sorter->compare = compare;
+    sorter->capacity = (memory - EXTERNAL_MIN_BUFFER) / recordSize;
+    sorter->count = 0;
+    sorter->records = malloc(sorter->capacity * recordSize);
+    sorter->writer.buffer = NULL;
+    sorter->runs = (struct runSet) {openTempFile(build->tmpDir), NULL, 0, 0};
+    // Test d'erreur. Si l'allocation ou la création a échoué, on renvoie -1.
+    if (sorter->records == NULL || sorter->runs.fd == -1 || initRunWriter(&sorter->writer, sorter->runs.fd, EXTERNAL_MIN_BUFFER) == -1) {
+        if (sorter->records == NULL) {
+            perror("malloc");
+        }
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Fonction qui trie le tampon d'un tri externe et l'écrit comme une suite.
+ *
+ * @param sorter tri externe.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int flushSorter(struct recordSorter* sorter) {
+    if (sorter->count == 0) {
+        return 0;
+    }
+    qsort(sorter->records, sorter->count, sorter->recordSize, sorter->compare);
+    for (size_t i = 0; i < sorter->count; i++) {
+        if (writeRecord(&sorter->writer, sorter->records + i * sorter->recordSize, sorter->recordSize) == -1) {
+            return -1;
+        }
+    }
+    if (appendRun(&sorter->runs, (int64_t) sorter->count) == -1) {
+        return -1;
+    }
+    sorter->count = 0;
+    return 0;
+}
+
+/**
+ * Fonction qui ajoute un enregistrement à un tri externe.
+ *
+ * @param sorter tri externe.
+ * @param record enregistrement.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int addRecord(struct recordSorter* sorter, const void* record) {
+    if (sorter->count == sorter->capacity && flushSorter(sorter) == -1) {
+        return -1;
+    }
+    memcpy(sorter->records + sorter->count * sorter->recordSize, record, sorter->recordSize);
+    sorter->count++;
+    return 0;
+}
+
+/**
+ * Fonction qui libère un tri externe (son tampon et ses suites).
+ *
+ * @param sorter tri externe.
+ */
+void freeSorter(struct recordSorter* sorter) {
+    free(sorter->records);
+    free(sorter->writer.buffer);
+    sorter->records = NULL;
+    sorter->writer.buffer = NULL;
+    closeRuns(&sorter->runs);
+}
+
+/**
+ * Fonction qui termine un tri externe : le tampon est libéré avant la
+ * fusion, qui dispose de tout le budget.
+ *
+ * @param sorter tri externe.
+ * @param result suite triée (résultat, à fermer par closeRuns()).
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int finishSorter(struct recordSorter* sorter, struct runSet* result) {
+    int err = flushSorter(sorter) == -1 || flushRunWriter(&sorter->writer) == -1;
+    free(sorter->records);
+    free(sorter->writer.buffer);
+    sorter->records = NULL;
+    sorter->writer.buffer = NULL;
+    err = err || mergeRuns(&sorter->runs, sorter->recordSize, sorter->compare, sorter->build) == -1;
+    *result = sorter->runs;
+    sorter->runs = (struct runSet) {-1, NULL, 0, 0};
+    if (err) {
+        closeRuns(result);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Fonction qui lit n octets d'un fichier à partir de offset.
+ *
+ * @param fd fichier.
+ * @param buffer tampon (résultat).
+ * @param length nombre d'octets.
+ * @param offset position dans le fichier.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int readFully(int fd, char* buffer, size_t length, off_t offset) {
+    size_t got = 0;
+    while (got < length) {
+        ssize_t r = pread(fd, buffer + got, length - got, offset + (off_t) got);
+        // Test d'erreur. Si la lecture a échoué, on renvoie -1.
+        if (r <= 0) {
+            perror("pread");
+            return -1;
+        }
+        got += (size_t) r;
+    }
+    return 0;
+}
+
+/**
+ * Fonction qui trie les suffixes de chaque bloc du texte avec SA-IS, et les
+ * écrit avec leur clé comme une suite triée selon la clé.
+ * Chaque bloc est lu avec les EXTERNAL_KEY_LENGTH caractères suivants : deux
+ * suffixes dont les clés diffèrent sont comparés avant la fin de la fenêtre,
+ * l'ordre de SA-IS est donc celui des clés.
+ *
+ * @param textFd fichier texte.
+ * @param build paramètres de la construction.
+ * @param runs suites des blocs (résultat).
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int sortBlocks(int textFd, struct externalBuild* build, struct runSet* runs) {
+    // Le bloc, sa fenêtre et le tableau de SA-IS tiennent dans le budget,
+    // avec le tampon d'écriture.
+    int64_t blockLength = (int64_t) (build->memoryBudget - EXTERNAL_MIN_BUFFER) / EXTERNAL_BLOCK_BYTES - EXTERNAL_KEY_LENGTH - 1;
+    if (blockLength > (int64_t) SA_INDEX_MAX - EXTERNAL_KEY_LENGTH - 2) {
+        blockLength = (int64_t) SA_INDEX_MAX - EXTERNAL_KEY_LENGTH - 2;
+    }
+    int64_t n = build->n;
+    char* window = malloc((size_t) ((n < blockLength ? n : blockLength) + EXTERNAL_KEY_LENGTH));
+    struct runWriter writer = {-1, NULL, 0, 0};
+    int err = window == NULL || initRunWriter(&writer, runs->fd, EXTERNAL_MIN_BUFFER) == -1;
+    if (window == NULL) {
+        perror("malloc");
+    }
+
+    for (int64_t start = 0; !err && start < n; start += blockLength) {
+        int64_t length = n - start < blockLength ? n - start : blockLength;
+        int64_t windowLength = n - start < length + EXTERNAL_KEY_LENGTH ? n - start : length + EXTERNAL_KEY_LENGTH;
+        err = readFully(textFd, window, (size_t) windowLength, (off_t) start) == -1;
+        saIndex* sa = err ? NULL : suffixArrayOf(window, (ptrdiff_t) windowLength);
+        err = err || sa == NULL;
+        // Suffixes qui commencent dans le bloc, dans l'ordre de SA-IS.
+        for (int64_t k = 0; !err && k < windowLength; k++) {
+            int64_t p = (int64_t) sa[k];
+            if (p >= length) {
+                continue;
+            }
+            struct keyRecord record;
+            record.pos = start + p;
+            record.keyLength = windowLength - p < EXTERNAL_KEY_LENGTH ? windowLength - p : EXTERNAL_KEY_LENGTH;
+            memset(record.key, 0, EXTERNAL_KEY_LENGTH);
+            memcpy(record.key, window + p, (size_t) record.keyLength);
+            err = writeRecord(&writer, &record, sizeof(record)) == -1;
+        }
+        free(sa);
+        err = err || appendRun(runs, length) == -1;
+    }
+    err = err || flushRunWriter(&writer) == -1;
+
+    free(writer.buffer);
+    free(window);
+    return err ? -1 : 0;
+}
+
+/**
+ * Fonction qui écrit les positions d'une suite de suffixes triés dans le
+ * fichier du tableau (depuis son début), et compte les groupes de suffixes
+ * égaux pour la fonction de comparaison. Le rang de chaque suffixe (position
+ * du premier suffixe de son groupe) est ajouté à ranks, avec sa position,
+ * pour le tri selon les positions.
+ *
+ * @param sorted suite triée.
+ * @param recordSize taille d'un enregistrement (struct keyRecord ou struct
+ *        rankRecord).
+ * @param compare fonction de comparaison des enregistrements.
+ * @param out fichier du tableau des suffixes.
+ * @param ranks tri des rangs selon les positions.
+ * @param build paramètres de la construction.
+ * @return le nombre de groupes, ou -1 en cas d'erreur.
+ */
+int64_t writeSortedSuffixes(struct runSet* sorted, size_t recordSize, int (*compare)(const void*, const void*), FILE* out, struct recordSorter* ranks, struct externalBuild* build) {
+    char* buffer = malloc(EXTERNAL_MIN_BUFFER);
+    // Test d'erreur. Si l'allocation a échoué, on renvoie -1.
+    if (buffer == NULL) {
+        perror("malloc");
+        return -1;
+    }
+    struct runReader reader;
+    initRunReader(&reader, sorted->fd, 0, (off_t) build->n * (off_t) recordSize, buffer, EXTERNAL_MIN_BUFFER);
+    // Enregistrement courant et précédent (le plus grand des deux types).
+    struct keyRecord records[2];
+    rewind(out);
+    int64_t groups = 0;
+    int64_t rank = 0;
+    int err = 0;
+    for (int64_t i = 0; !err && i < build->n; i++) {
+        void* current = &records[i % 2];
+        err = readRecord(&reader, current, recordSize) != 1;
+        if (err) {
+            break;
+        }
+        if (i == 0 || compare(&records[(i + 1) % 2], current) != 0) {
+            groups++;
+            rank = i;
+        }
+        int64_t pos = recordSize == sizeof(struct keyRecord) ? ((struct keyRecord*) current)->pos : ((struct rankRecord*) current)->value;
+        err = fwrite(&pos, sizeof(int64_t), 1, out) != 1;
+        if (!err) {
+            struct rankRecord record = {pos, 0, rank};
+            err = addRecord(ranks, &record) == -1;
+        }
+    }
+    free(buffer);
+    return err ? -1 : groups;
+}
+
+/**
+ * Fonction qui termine le tri des suffixes par doublement des préfixes, à
+ * partir de leurs rangs pour leurs h premiers caractères.
+ * À chaque tour, les rangs sont lus dans l'ordre du texte par deux lecteurs,
+ * l'un en i et l'autre en i + h : les couples (rang de i, rang de i + h) sont
+ * triés, puis renumérotés, et les nouveaux rangs triés selon les positions.
+ * Le tableau des suffixes est écrit à chaque tour ; le dernier (rangs tous
+ * distincts) est le bon.
+ *
+ * @param ranks rangs triés selon les positions (struct rankRecord (position,
+ *        0, rang)), fermés par la fonction.
+ * @param h nombre de caractères dont les rangs tiennent compte.
+ * @param out fichier du tableau des suffixes.
+ * @param build paramètres de la construction.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int doubleRanks(struct runSet* ranks, int64_t h, FILE* out, struct externalBuild* build) {
+    size_t recordSize = sizeof(struct rankRecord);
+    size_t sorterMemory = build->memoryBudget - 3 * EXTERNAL_MIN_BUFFER;
+    off_t end = (off_t) build->n * (off_t) recordSize;
+    int err = 0;
+
+    for (; !err; h *= 2) {
+        // Couples (rang de i, rang de i + h, i), triés. Les tampons des deux
+        // lecteurs sont libérés avant la fusion, qui dispose de tout le
+        // budget.
+        struct recordSorter pairs;
+        char* buffers = malloc(2 * EXTERNAL_MIN_BUFFER);
+        err = buffers == NULL || initSorter(&pairs, build, recordSize, &compareRankRecords, sorterMemory) == -1;
+        if (buffers == NULL) {
+            perror("malloc");
+            break;
+        }
+        struct runReader at;
+        struct runReader after;
+        initRunReader(&at, ranks->fd, 0, end, buffers, EXTERNAL_MIN_BUFFER);
+        initRunReader(&after, ranks->fd, h < build->n ? (off_t) h * (off_t) recordSize : end, end, buffers + EXTERNAL_MIN_BUFFER, EXTERNAL_MIN_BUFFER);
+        for (int64_t i = 0; !err && i < build->n; i++) {
+            struct rankRecord current;
+            struct rankRecord next = {0, 0, -1};
+            err = readRecord(&at, &current, recordSize) != 1 || (i + h < build->n && readRecord(&after, &next, recordSize) != 1);
+            struct rankRecord pair = {current.value, next.value, i};
+            err = err || addRecord(&pairs, &pair) == -1;
+        }
+        free(buffers);
+        closeRuns(ranks);
+        struct runSet sorted = {-1, NULL, 0, 0};
+        err = err || finishSorter(&pairs, &sorted) == -1;
+        freeSorter(&pairs);
+
+        // Nouveaux rangs, triés selon les positions.
+        struct recordSorter byPosition;
+        err = err || initSorter(&byPosition, build, recordSize, &compareRankRecords, sorterMemory) == -1;
+        int64_t groups = err ? -1 : writeSortedSuffixes(&sorted, recordSize, &compareRankRecords, out, &byPosition, build);
+        closeRuns(&sorted);
+        err = err || groups == -1;
+        // Tous les rangs sont distincts : les suffixes sont triés.
+        if (!err && groups == build->n) {
+            freeSorter(&byPosition);
+            break;
+        }
+        err = err || finishSorter(&byPosition, ranks) == -1;
+        freeSorter(&byPosition);
+    }
+
+    closeRuns(ranks);
+    return err ? -1 : 0;
+}
+
+/**
+ * Fonction qui construit le tableau des suffixes du fichier textFilename dans
+ * le fichier saFilename, en utilisant au plus memoryBudget octets (blocs,
+ * tris et tampons).
+ *
+ * @param textFilename nom du fichier texte.
+ * @param saFilename nom du fichier du tableau des suffixes (résultat).
+ * @param memoryBudget budget mémoire en octets (au moins
+ *        EXTERNAL_MIN_BUDGET).
+ * @param tmpDir répertoire des fichiers temporaires.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int buildExternalSuffixArray(const char* textFilename, const char* saFilename, size_t memoryBudget, const char* tmpDir) {
+    // Test d'erreur. Si le budget est trop petit, on renvoie -1.
+    if (memoryBudget < EXTERNAL_MIN_BUDGET) {
+        fprintf(stderr, "Le budget mémoire doit être d'au moins %d octets.\n", EXTERNAL_MIN_BUDGET);
+        return -1;
+    }
+    int textFd = open(textFilename, O_RDONLY);
+    struct stat status;
+    // Test d'erreur. Si l'ouverture a échoué, on renvoie -1.
+    if (textFd == -1 || fstat(textFd, &status) == -1) {
+        perror(textFilename);
+        if (textFd != -1) {
+            close(textFd);
+        }
+        return -1;
+    }
+    struct externalBuild build = {memoryBudget, tmpDir, (int64_t) status.st_size};
+    FILE* out = fopen(saFilename, "w");
+    if (out == NULL) {
+        perror(saFilename);
+        close(textFd);
+        return -1;
+    }
+
+    // Blocs triés par SA-IS, fusionnés selon les clés.
+    struct runSet sorted = {openTempFile(tmpDir), NULL, 0, 0};
+    int err = sorted.fd == -1 || sortBlocks(textFd, &build, &sorted) == -1
+              || mergeRuns(&sorted, sizeof(struct keyRecord), &compareKeyRecords, &build) == -1;
+    close(textFd);
+    // Écriture du tableau selon les clés. Les rangs sont triés selon les
+    // positions dans la même passe, sans savoir encore s'ils serviront : on
+    // ne sait qu'à la fin s'il y a des clés égales.
+    if (!err) {
+        struct recordSorter byPosition;
+        err = initSorter(&byPosition, &build, sizeof(struct rankRecord), &compareRankRecords, memoryBudget - 2 * EXTERNAL_MIN_BUFFER) == -1;
+        int64_t groups = err ? -1 : writeSortedSuffixes(&sorted, sizeof(struct keyRecord), &compareKeyRecords, out, &byPosition, &build);
+        closeRuns(&sorted);
+        err = err || groups == -1;
+
+        // Clés égales : les rangs des suffixes pour leurs EXTERNAL_KEY_LENGTH
+        // premiers caractères servent au doublement des préfixes. Sinon, le
+        // tableau est déjà le bon et les rangs sont abandonnés.
+        if (!err && groups < build.n) {
+            struct runSet ranks = {-1, NULL, 0, 0};
+            err = finishSorter(&byPosition, &ranks) == -1;
+            err = err || doubleRanks(&ranks, EXTERNAL_KEY_LENGTH, out, &build) == -1;
+            closeRuns(&ranks);
+        }
+        freeSorter(&byPosition);
+    }
+    closeRuns(&sorted);
+
+    err = fclose(out) != 0 || err;
+    if (err) {
+        fprintf(stderr, "Erreur lors de la construction de %s.\n", saFilename);
+    }
+    return err ? -1 : 0;
+}
+
+/**
+ * Fonction qui projette en mémoire un texte et son tableau des suffixes
+ * construit par buildExternalSuffixArray().
+ *
+ * @param textFilename nom du fichier texte.
+ * @param saFilename nom du fichier du tableau des suffixes.
+ * @param index tableau projeté (résultat).
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int openExternalSuffixArray(const char* textFilename, const char* saFilename, struct externalSuffixArray* index) {
+    if (mapText(textFilename, 0, 0, &index->text) == -1) {
+        return -1;
+    }
+    if (mapText(saFilename, 0, 0, &index->array) == -1) {
+        unmapText(&index->text);
+        return -1;
+    }
+    // Test d'erreur. Si le tableau n'est pas celui du texte, on renvoie -1.
+    if (index->array.length != index->text.length * sizeof(int64_t)) {
+        fprintf(stderr, "%s n'est pas le tableau des suffixes de %s.\n", saFilename, textFilename);
+        unmapText(&index->array);
+        unmapText(&index->text);
+        return -1;
+    }
+    // Les recherches dichotomiques lisent les deux fichiers dans le désordre.
+    posix_madvise(index->text.text, index->text.mappedLength, POSIX_MADV_RANDOM);
+    posix_madvise(index->array.text, index->array.mappedLength, POSIX_MADV_RANDOM);
+    index->sa = (int64_t*) (void*) index->array.text;
+    index->length = (ptrdiff_t) index->text.length;
+    return 0;
+}
+
+/**
+ * Fonction qui libère un tableau projeté par openExternalSuffixArray().
+ *
+ * @param index tableau projeté.
+ */
+void closeExternalSuffixArray(struct externalSuffixArray* index) {
+    unmapText(&index->array);
+    unmapText(&index->text);
+    index->sa = NULL;
+}
+
+/**
+ * Fonction qui renvoie le rang du premier suffixe supérieur au mot, complété
+ * par un caractère plus petit (upper = 0) ou plus grand (upper = 1) que tous
+ * les autres (voir suffixArrayBound() dans suffixArray.h).
+ * Sans tableaux LCP, la comparaison reprend après le plus petit des préfixes
+ * communs du mot avec les deux bornes, qui est aussi commun au milieu.
+ *
+ * @param index tableau projeté.
+ * @param word mot.
+ * @param wordLength longueur du mot.
+ * @param upper 0 pour la borne inférieure, 1 pour la borne supérieure.
+ * @return le rang (entre 0 et la longueur du texte).
+ */
+ptrdiff_t externalSuffixArrayBound(struct externalSuffixArray* index, char* word, int wordLength, int upper) {
+    const unsigned char* text = (const unsigned char*) index->text.text;
+    const unsigned char* w = (const unsigned char*) word;
+    ptrdiff_t n = index->length;
+    ptrdiff_t left = -1;
+    ptrdiff_t right = n;
+    ptrdiff_t leftLcp = 0;
+    ptrdiff_t rightLcp = 0;
+
+    while (right - left > 1) {
+        ptrdiff_t mid = left + (right - left) / 2;
+        ptrdiff_t h = leftLcp < rightLcp ? leftLcp : rightLcp;
+        ptrdiff_t pos = (ptrdiff_t) index->sa[mid];
+        while (h < wordLength && pos + h < n && w[h] == text[pos + h]) {
+            h++;
+        }
+        int suffixIsSmaller;
+        if (h == wordLength) {
+            suffixIsSmaller = upper;
+        } else if (pos + h == n) {
+            suffixIsSmaller = 1;
+        } else {
+            suffixIsSmaller = text[pos + h] < w[h];
+        }
+        if (suffixIsSmaller) {
+            left = mid;
+            leftLcp = h;
+        } else {
+            right = mid;
+            rightLcp = h;
+        }
+    }
+    return right;
+}
+
+/**
+ * Fonction qui compte les occurrences d'un mot avec un tableau projeté.
+ *
+ * @param index tableau projeté.
+ * @param word mot à rechercher.
+ * @param wordLength longueur du mot.
+ * @return le nombre d'occurrences, ou -2 en cas d'erreur.
+ */
+long long externalSuffixArrayCount(struct externalSuffixArray* index, char* word, int wordLength) {
+    // Test d'erreur. Si l'index ou le mot est NULL, on renvoie -2.
+    if (index == NULL || index->sa == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+    return (long long) (externalSuffixArrayBound(index, word, wordLength, 1) - externalSuffixArrayBound(index, word, wordLength, 0));
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot avec un tableau
+ * projeté. Les occurrences sont transmises dans l'ordre des suffixes.
+ *
+ * @param index tableau projeté.
+ * @param word mot à rechercher.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long externalSuffixArrayLocate(struct externalSuffixArray* index, char* word, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si l'index ou le mot est NULL, on renvoie -2.
+    if (index == NULL || index->sa == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+    ptrdiff_t first = externalSuffixArrayBound(index, word, wordLength, 0);
+    ptrdiff_t last = externalSuffixArrayBound(index, word, wordLength, 1);
+    if (report != NULL) {
+        for (ptrdiff_t i = first; i < last; i++) {
+            if (report((ptrdiff_t) index->sa[i], data) != 0) {
+                return (long long) (i - first) + 1;
+            }
+        }
+    }
+    return (long long) (last - first);
+}
+
+#endif
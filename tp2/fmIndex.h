@@ -0,0 +1,453 @@
+/**
+ * FICHIER:
+ * --------
+ * fmIndex.h
+ *
+ * DESCRIPTION:
+ * ------------
+ * Ce fichier contient un index compressé du texte : l'index FM (Ferragina et
+ * Manzini). Il remplace le texte et son tableau des suffixes par :
+ *
+ * - la transformée de Burrows-Wheeler (BWT) du texte suivi d'une sentinelle,
+ *   rangée dans une matrice d'ondelettes : un vecteur de n bits par bit du
+ *   code des lettres (log2 de la taille de l'alphabet), avec un compteur de
+ *   bits à 1 tous les 512 bits pour le rang en temps constant ;
+ * - le tableau counts (nombre de lettres plus petites que chaque lettre) ;
+ * - un échantillon du tableau des suffixes : les positions multiples de
+ *   sampleRate, et le vecteur de bits des lignes échantillonnées.
+ *
+ * Le comptage (recherche arrière) lit les lettres du mot de la dernière à la
+ * première, en O(m log(sigma)), sans lire le texte. La localisation remonte
+ * chaque occurrence par la fonction LF jusqu'à une ligne échantillonnée
+ * (sampleRate - 1 pas au plus).
+ *
+ * Pour un alphabet de taille sigma, l'index occupe environ
+ * 1,125 * log2(sigma) + 1,125 + 32 / sampleRate bits par caractère : 4,4 bits
+ * pour l'ADN avec sampleRate = 32, au lieu de 8 pour le texte et de 96 pour
+ * l'index de suffixArray.h. La construction passe par le tableau des suffixes
+ * (SA-IS), libéré ensuite.
+ *
+ * AUTEUR:
+ * -------
+ * M. TAIA
+ */
+
+#ifndef FM_INDEX_H
+#define FM_INDEX_H
+
+////////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+////////////////////////////////////////////////////////////////////////////////
+#include "suffixArray.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINES
+////////////////////////////////////////////////////////////////////////////////
+// Écart par défaut entre deux positions échantillonnées du tableau des
+// suffixes.
+#define FM_SAMPLE_RATE 32
+
+// Nombre de mots de 64 bits entre deux compteurs de rang (512 bits).
+#define RANK_BLOCK_WORDS 8
+
+// Nombre maximal de niveaux de la matrice d'ondelettes (lettres sur 8 bits).
+#define FM_MAX_LEVELS 8
+
+////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Vecteur de bits avec rang : blocks[k] est le nombre de bits à 1 dans les
+ * k * RANK_BLOCK_WORDS premiers mots.
+ */
+struct rankBits {
+    uint64_t* words;
+    uint64_t* blocks;
+};
+
+/**
+ * Index FM d'un texte, créé par buildFmIndex() et libéré par freeFmIndex().
+ * Les lignes de la BWT sont numérotées de 0 à length : la ligne 0 est le
+ * suffixe vide (la sentinelle seule).
+ */
+struct fmIndex {
+    ptrdiff_t length; // Longueur du texte
+    ptrdiff_t primary; // Ligne dont la lettre de BWT est la sentinelle
+    int sigma; // Nombre de lettres distinctes du texte
+    int levels; // Nombre de bits du code des lettres
+    int codes[256]; // Code de chaque lettre (-1 si absente)
+    ptrdiff_t counts[256]; // Nombre de lignes qui commencent par une lettre de code plus petit (sentinelle comprise)
+    ptrdiff_t starts[256]; // Début du bloc de chaque code au dernier niveau
+    ptrdiff_t zeros[FM_MAX_LEVELS]; // Nombre de bits à 0 de chaque niveau
+    struct rankBits bits[FM_MAX_LEVELS]; // Niveaux de la matrice d'ondelettes
+    struct rankBits sampled; // Lignes échantillonnées
+    saIndex* samples; // Positions des lignes échantillonnées, dans l'ordre des lignes
+    int sampleRate;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Fonctions
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Fonction qui alloue un vecteur de bits nuls de longueur donnée.
+ *
+ * @param bits vecteur de bits (résultat).
+ * @param length nombre de bits.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int allocRankBits(struct rankBits* bits, ptrdiff_t length) {
+    size_t nbWords = (size_t) (length / 64) + 1;
+    bits->words = calloc(nbWords, sizeof(uint64_t));
+    bits->blocks = calloc(nbWords / RANK_BLOCK_WORDS + 1, sizeof(uint64_t));
+    // Test d'erreur. Si une allocation a échoué, on renvoie -1.
+    if (bits->words == NULL || bits->blocks == NULL) {
+        perror("calloc");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Fonction qui calcule les compteurs de rang d'un vecteur de bits, une fois
+ * tous ses bits placés.
+ *
+ * @param bits vecteur de bits.
+ * @param length nombre de bits.
+ */
+void finishRankBits(struct rankBits* bits, ptrdiff_t length) {
+    size_t nbWords = (size_t) (length / 64) + 1;
+    uint64_t count = 0;
+    for (size_t w = 0; w < nbWords; w++) {
+        if (w % RANK_BLOCK_WORDS == 0) {
+            bits->blocks[w / RANK_BLOCK_WORDS] = count;
+        }
+        count += (uint64_t) __builtin_popcountll(bits->words[w]);
+    }
+}
+
+/**
+ * Fonction qui libère un vecteur de bits.
+ *
+ * @param bits vecteur de bits.
+ */
+void freeRankBits(struct rankBits* bits) {
+    free(bits->words);
+    free(bits->blocks);
+    bits->words = NULL;
+    bits->blocks = NULL;
+}
+
+/**
+ * Fonction qui renvoie le bit i d'un vecteur de bits.
+ *
+ * @param bits vecteur de bits.
+ * @param i position du bit.
+ * @return le bit.
+ */
+static inline int getRankBit(const struct rankBits* bits, ptrdiff_t i) {
+    return (int) ((bits->words[i / 64] >> (i % 64)) & 1);
+}
+
+/**
+ * Fonction qui renvoie le nombre de bits à 1 avant la position i.
+ *
+ * @param bits vecteur de bits.
+ * @param i position (de 0 à la longueur du vecteur).
+ * @return le nombre de bits à 1 dans [0, i[.
+ */
+static inline ptrdiff_t rank1(const struct rankBits* bits, ptrdiff_t i) {
+    ptrdiff_t w = i / 64;
+    uint64_t count = bits->blocks[w / RANK_BLOCK_WORDS];
+    for (ptrdiff_t k = w - w % RANK_BLOCK_WORDS; k < w; k++) {
+        count += (uint64_t) __builtin_popcountll(bits->words[k]);
+    }
+    if (i % 64 != 0) {
+        count += (uint64_t) __builtin_popcountll(bits->words[w] & ((UINT64_C(1) << (i % 64)) - 1));
+    }
+    return (ptrdiff_t) count;
+}
+
+/**
+ * Fonction qui renvoie le nombre de lettres de code c dans les i premières
+ * lignes de la BWT.
+ * Le code suit les bits de c d'un niveau au suivant : au dernier niveau, les
+ * lettres de code c forment un bloc qui commence à starts[c]. La sentinelle
+ * est rangée avec le code 0 : elle est retirée du compte.
+ *
+ * @param index index FM.
+ * @param c code de la lettre.
+ * @param i nombre de lignes.
+ * @return le rang.
+ */
+static inline ptrdiff_t fmRank(const struct fmIndex* index, int c, ptrdiff_t i) {
+    ptrdiff_t pos = i;
+    for (int l = 0; l < index->levels; l++) {
+        ptrdiff_t ones = rank1(&index->bits[l], pos);
+        pos = ((c >> (index->levels - 1 - l)) & 1) ? index->zeros[l] + ones : pos - ones;
+    }
+    return pos - index->starts[c] - (c == 0 && i > index->primary);
+}
+
+/**
+ * Fonction LF : renvoie la ligne du suffixe qui commence un caractère avant
+ * celui de la ligne row. La lettre de BWT de la ligne est lue en même temps
+ * que son rang.
+ *
+ * @param index index FM.
+ * @param row ligne (différente de primary).
+ * @return la ligne précédente dans le texte.
+ */
+static inline ptrdiff_t fmLF(const struct fmIndex* index, ptrdiff_t row) {
+    ptrdiff_t pos = row;
+    int c = 0;
+    for (int l = 0; l < index->levels; l++) {
+        int bit = getRankBit(&index->bits[l], pos);
+        ptrdiff_t ones = rank1(&index->bits[l], pos);
+        pos = bit ? index->zeros[l] + ones : pos - ones;
+        c = (c << 1) | bit;
+    }
+    return index->counts[c] + pos - index->starts[c] - (c == 0 && row > index->primary);
+}
+
+/**
+ * Fonction qui libère un index créé par buildFmIndex().
+ *
+ * @param index index à libérer (ou NULL).
+ */
+void freeFmIndex(struct fmIndex* index) {
+    if (index != NULL) {
+        for (int l = 0; l < FM_MAX_LEVELS; l++) {
+            freeRankBits(&index->bits[l]);
+        }
+        freeRankBits(&index->sampled);
+        free(index->samples);
+        free(index);
+    }
+}
+
+/**
+ * Fonction qui construit l'index FM d'un texte.
+ * Les lettres du texte reçoivent les codes 0 à sigma - 1 dans l'ordre des
+ * octets. La BWT est calculée à partir du tableau des suffixes, puis chaque
+ * niveau de la matrice d'ondelettes reçoit un bit des codes, les codes étant
+ * ensuite répartis (ceux dont le bit vaut 0 d'abord, dans le même ordre)
+ * pour le niveau suivant.
+ *
+ * @param text texte à indexer (il n'est plus utilisé ensuite).
+ * @param textLength longueur du texte (au plus SA_INDEX_MAX - 2).
+ * @param sampleRate écart entre deux positions échantillonnées (au moins 1).
+ * @return l'index, ou NULL en cas d'erreur.
+ */
+struct fmIndex* buildFmIndex(char* text, ptrdiff_t textLength, int sampleRate) {
+    // Test d'erreur. Si le texte est NULL ou trop long, on renvoie NULL.
+    if (text == NULL || textLength < 0 || textLength >= SA_INDEX_MAX - 1 || sampleRate < 1) {
+        return NULL;
+    }
+    struct fmIndex* index = calloc(1, sizeof(struct fmIndex));
+    // Test d'erreur. Si l'allocation a échoué, on renvoie NULL.
+    if (index == NULL) {
+        perror("calloc");
+        return NULL;
+    }
+    ptrdiff_t n = textLength;
+    ptrdiff_t rows = n + 1;
+    index->length = n;
+    index->sampleRate = sampleRate;
+
+    // Codes des lettres et tableau counts.
+    ptrdiff_t occurrences[256] = {0};
+    for (ptrdiff_t i = 0; i < n; i++) {
+        occurrences[(unsigned char) text[i]]++;
+    }
+    index->sigma = 0;
+    ptrdiff_t smaller = 1;
+    for (int c = 0; c < 256; c++) {
+        index->codes[c] = -1;
+        if (occurrences[c] > 0) {
+            index->codes[c] = index->sigma;
+            index->counts[index->sigma] = smaller;
+            smaller += occurrences[c];
+            index->sigma++;
+        }
+    }
+    index->levels = 1;
+    while ((1 << index->levels) < index->sigma) {
+        index->levels++;
+    }
+
+    // BWT (codes) et échantillon du tableau des suffixes.
+    saIndex* sa = suffixArrayOf(text, n);
+    unsigned char* bwt = malloc((size_t) rows);
+    unsigned char* next = malloc((size_t) rows);
+    index->samples = malloc(sizeof(saIndex) * (size_t) (n / sampleRate + 1));
+    // Test d'erreur. Si une allocation a échoué, on renvoie NULL.
+    if (sa == NULL || bwt == NULL || next == NULL || index->samples == NULL || allocRankBits(&index->sampled, rows) == -1) {
+        free(sa);
+        free(bwt);
+        free(next);
+        freeFmIndex(index);
+        return NULL;
+    }
+    ptrdiff_t nbSamples = 0;
+    for (ptrdiff_t row = 0; row < rows; row++) {
+        // La ligne 0 est le suffixe vide, de position n.
+        ptrdiff_t pos = row == 0 ? n : sa[row - 1];
+        if (pos == 0) {
+            index->primary = row;
+            bwt[row] = 0;
+        } else {
+            bwt[row] = (unsigned char) index->codes[(unsigned char) text[pos - 1]];
+        }
+        if (pos % sampleRate == 0) {
+            index->sampled.words[row / 64] |= UINT64_C(1) << (row % 64);
+            index->samples[nbSamples++] = (saIndex) pos;
+        }
+    }
+    finishRankBits(&index->sampled, rows);
+    free(sa);
+
+    // Niveaux de la matrice d'ondelettes, du bit de poids fort au plus faible.
+    for (int l = 0; l < index->levels; l++) {
+        int shift = index->levels - 1 - l;
+        if (allocRankBits(&index->bits[l], rows) == -1) {
+            free(bwt);
+            free(next);
+            freeFmIndex(index);
+            return NULL;
+        }
+        ptrdiff_t nbZeros = 0;
+        for (ptrdiff_t i = 0; i < rows; i++) {
+            if ((bwt[i] >> shift) & 1) {
+                index->bits[l].words[i / 64] |= UINT64_C(1) << (i % 64);
+            } else {
+                nbZeros++;
+            }
+        }
+        finishRankBits(&index->bits[l], rows);
+        index->zeros[l] = nbZeros;
+        ptrdiff_t zero = 0;
+        ptrdiff_t one = nbZeros;
+        for (ptrdiff_t i = 0; i < rows; i++) {
+            next[((bwt[i] >> shift) & 1) ? one++ : zero++] = bwt[i];
+        }
+        unsigned char* swap = bwt;
+        bwt = next;
+        next = swap;
+    }
+    free(bwt);
+    free(next);
+
+    // Début du bloc de chaque code au dernier niveau.
+    for (int c = 0; c < index->sigma; c++) {
+        ptrdiff_t pos = 0;
+        for (int l = 0; l < index->levels; l++) {
+            ptrdiff_t ones = rank1(&index->bits[l], pos);
+            pos = ((c >> (index->levels - 1 - l)) & 1) ? index->zeros[l] + ones : pos - ones;
+        }
+        index->starts[c] = pos;
+    }
+    return index;
+}
+
+/**
+ * Fonction qui renvoie la taille de l'index en octets (sans la structure).
+ *
+ * @param index index FM.
+ * @return la taille en octets.
+ */
+ptrdiff_t fmIndexSize(struct fmIndex* index) {
+    ptrdiff_t nbWords = index->length / 64 + 2;
+    ptrdiff_t bitsSize = (nbWords + nbWords / RANK_BLOCK_WORDS + 1) * (ptrdiff_t) sizeof(uint64_t);
+    return (index->levels + 1) * bitsSize + (index->length / index->sampleRate + 1) * (ptrdiff_t) sizeof(saIndex);
+}
+
+/**
+ * Fonction qui calcule l'intervalle [first, last[ des lignes qui commencent
+ * par le mot (recherche arrière).
+ *
+ * @param index index FM.
+ * @param word mot.
+ * @param wordLength longueur du mot.
+ * @param first première ligne (résultat).
+ * @param last ligne qui suit la dernière (résultat).
+ */
+void fmIndexRange(struct fmIndex* index, char* word, int wordLength, ptrdiff_t* first, ptrdiff_t* last) {
+    ptrdiff_t sp = 0;
+    ptrdiff_t ep = index->length + 1;
+    for (int j = wordLength - 1; j >= 0 && sp < ep; j--) {
+        int c = index->codes[(unsigned char) word[j]];
+        // Lettre absente du texte : aucune occurrence.
+        if (c < 0) {
+            sp = ep;
+            break;
+        }
+        sp = index->counts[c] + fmRank(index, c, sp);
+        ep = index->counts[c] + fmRank(index, c, ep);
+    }
+    *first = sp;
+    *last = sp < ep ? ep : sp;
+}
+
+/**
+ * Fonction qui compte les occurrences d'un mot dans le texte indexé.
+ *
+ * @param index index FM.
+ * @param word mot à rechercher.
+ * @param wordLength longueur du mot.
+ * @return le nombre d'occurrences, ou -2 en cas d'erreur.
+ */
+long long fmIndexCount(struct fmIndex* index, char* word, int wordLength) {
+    // Test d'erreur. Si l'index ou le mot est NULL, on renvoie -2.
+    if (index == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+    ptrdiff_t first;
+    ptrdiff_t last;
+    fmIndexRange(index, word, wordLength, &first, &last);
+    return (long long) (last - first);
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans le texte
+ * indexé. Les occurrences sont transmises dans l'ordre des suffixes, et non
+ * dans l'ordre du texte.
+ *
+ * @param index index FM.
+ * @param word mot à rechercher.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long fmIndexLocate(struct fmIndex* index, char* word, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si l'index ou le mot est NULL, on renvoie -2.
+    if (index == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+    ptrdiff_t first;
+    ptrdiff_t last;
+    fmIndexRange(index, word, wordLength, &first, &last);
+    if (report != NULL) {
+        for (ptrdiff_t row = first; row < last; row++) {
+            // Remontée jusqu'à une ligne échantillonnée.
+            ptrdiff_t r = row;
+            ptrdiff_t steps = 0;
+            while (!getRankBit(&index->sampled, r)) {
+                r = fmLF(index, r);
+                steps++;
+            }
+            if (report(index->samples[rank1(&index->sampled, r)] + steps, data) != 0) {
+                return (long long) (row - first) + 1;
+            }
+        }
+    }
+    return (long long) (last - first);
+}
+
+#endif
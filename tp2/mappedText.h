@@ -0,0 +1,138 @@
+/**
+ * FICHIER:
+ * --------
+ * mappedText.h
+ *
+ * DESCRIPTION:
+ * ------------
+ * Ce fichier contient le chargement d'un texte par projection en mémoire
+ * (mmap) : le fichier n'est ni copié ni tronqué, les algorithmes reçoivent un
+ * pointeur et une longueur. Il est utilisé par les programmes de tp2 et de
+ * tp3.
+ *
+ * La projection est privée. Elle est suivie de padding octets nuls, pour les
+ * algorithmes qui lisent ou écrivent un caractère après la fin du texte
+ * (sentinelle, '\0' final). Avec MAPPED_TEXT_WRITABLE, le texte et les octets
+ * suivants sont modifiables, les pages modifiées étant copiées (le fichier
+ * n'est jamais modifié).
+ *
+ * Le noyau est prévenu que le texte est lu séquentiellement
+ * (POSIX_MADV_SEQUENTIAL). Avec MAPPED_TEXT_HUGE_PAGES, on lui demande aussi
+ * des pages de grande taille, quand le système le permet.
+ *
+ * AUTEUR:
+ * -------
+ * M. TAIA
+ */
+
+#ifndef MAPPED_TEXT_H
+#define MAPPED_TEXT_H
+
+////////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+////////////////////////////////////////////////////////////////////////////////
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINES
+////////////////////////////////////////////////////////////////////////////////
+// Options de mapText().
+#define MAPPED_TEXT_WRITABLE 1
+#define MAPPED_TEXT_HUGE_PAGES 2
+
+////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Texte projeté en mémoire par mapText(), libéré par unmapText().
+ */
+struct mappedText {
+    char* text; // Premier caractère du texte
+    size_t length; // Longueur du texte (taille du fichier)
+    size_t mappedLength; // Taille de la projection (padding compris)
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Fonctions
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Fonction qui projette en mémoire le fichier filename, suivi de padding
+ * octets nuls.
+ * Une zone anonyme de la taille totale est d'abord réservée, puis le fichier
+ * est projeté à son début : les octets qui suivent le fichier sont ainsi
+ * toujours accessibles, même quand sa taille est un multiple de la taille
+ * des pages.
+ *
+ * @param filename nom du fichier à projeter.
+ * @param padding nombre d'octets nuls après le texte.
+ * @param flags options (MAPPED_TEXT_WRITABLE, MAPPED_TEXT_HUGE_PAGES).
+ * @param mapped texte projeté (résultat).
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int mapText(const char* filename, size_t padding, int flags, struct mappedText* mapped) {
+    int fd = open(filename, O_RDONLY);
+    // Test d'erreur. Si l'ouverture a échoué, on renvoie -1.
+    if (fd == -1) {
+        perror(filename);
+        return -1;
+    }
+    struct stat info;
+    // Test d'erreur. Si la taille est inconnue, on renvoie -1.
+    if (fstat(fd, &info) == -1) {
+        perror("fstat");
+        close(fd);
+        return -1;
+    }
+    size_t length = (size_t) info.st_size;
+    // Une projection ne peut pas être vide.
+    size_t mappedLength = length + padding > 0 ? length + padding : 1;
+    int protection = PROT_READ | ((flags & MAPPED_TEXT_WRITABLE) ? PROT_WRITE : 0);
+
+    // Réservation de la zone, puis projection du fichier à son début.
+    char* base = mmap(NULL, mappedLength, protection, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    // Test d'erreur. Si la réservation a échoué, on renvoie -1.
+    if (base == MAP_FAILED) {
+        perror("mmap");
+        close(fd);
+        return -1;
+    }
+    if (length > 0 && mmap(base, length, protection, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        perror("mmap");
+        munmap(base, mappedLength);
+        close(fd);
+        return -1;
+    }
+    // La projection reste valide après la fermeture du fichier.
+    close(fd);
+
+    // Conseils au noyau : les échecs ne sont pas des erreurs.
+    posix_madvise(base, mappedLength, POSIX_MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    if (flags & MAPPED_TEXT_HUGE_PAGES) {
+        madvise(base, mappedLength, MADV_HUGEPAGE);
+    }
+#endif
+
+    mapped->text = base;
+    mapped->length = length;
+    mapped->mappedLength = mappedLength;
+    return 0;
+}
+
+/**
+ * Fonction qui libère un texte projeté par mapText().
+ *
+ * @param mapped texte projeté.
+ */
+void unmapText(struct mappedText* mapped) {
+    if (mapped->text != NULL) {
+        munmap(mapped->text, mapped->mappedLength);
+        mapped->text = NULL;
+    }
+}
+
+#endif
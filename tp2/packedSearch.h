@@ -0,0 +1,271 @@
+/**
+ * FICHIER:
+ * --------
+ * packedSearch.h
+ *
+ * DESCRIPTION:
+ * ------------
+ * Ce fichier contient la recherche dans un texte compacté à 2 bits par
+ * caractère, pour les textes d'au plus 4 lettres (séquences d'ADN, alphabet
+ * de taille 4 de runTests.sh).
+ *
+ * Le texte est converti une fois par packText() : les lettres distinctes
+ * reçoivent les codes 0 à 3 dans l'ordre des octets, et 32 caractères sont
+ * rangés dans chaque mot de 64 bits (le caractère i dans les bits 2 * (i % 32)
+ * et 2 * (i % 32) + 1 du mot i / 32). Le texte occupe 4 fois moins de
+ * mémoire, et la recherche teste les 32 positions d'un mot du texte à la fois
+ * (comparaison SWAR, voir packedOccurrences()).
+ *
+ * AUTEUR:
+ * -------
+ * M. TAIA
+ */
+
+#ifndef PACKED_SEARCH_H
+#define PACKED_SEARCH_H
+
+////////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+////////////////////////////////////////////////////////////////////////////////
+#include "exactSearchAlgos.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINES
+////////////////////////////////////////////////////////////////////////////////
+// Nombre de caractères par mot de 64 bits.
+#define PACKED_SYMBOLS 32
+
+// Nombre maximal de caractères du mot comparés par le filtre SWAR de
+// packedOccurrences() ; la suite du mot n'est vérifiée qu'aux positions
+// retenues.
+#define PACKED_FILTER 8
+
+// Bit de poids faible de chaque caractère d'un mot de 64 bits.
+#define PACKED_LOW_BITS 0x5555555555555555ull
+
+////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Texte compacté à 2 bits par caractère, créé par packText() et libéré par
+ * freePackedText().
+ */
+struct packedText {
+    uint64_t* words; // Caractères compactés (un mot nul de plus à la fin)
+    ptrdiff_t length; // Nombre de caractères du texte
+    int alphabetSize; // Nombre de lettres distinctes (1 à 4)
+    unsigned char letters[4]; // Lettre de chaque code
+    signed char codes[256]; // Code de chaque lettre (-1 si absente)
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Fonctions
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Fonction qui compacte un texte d'au plus 4 lettres distinctes à 2 bits par
+ * caractère.
+ *
+ * @param text texte à compacter.
+ * @param textLength longueur du texte.
+ * @param packed texte compacté (résultat).
+ * @return 0 en cas de succès, -1 si le texte a plus de 4 lettres ou en cas
+ *         d'erreur.
+ */
+int packText(char* text, ptrdiff_t textLength, struct packedText* packed) {
+    // Test d'erreur. Si le texte est NULL, on renvoie -1.
+    if (text == NULL || textLength < 0) {
+        return -1;
+    }
+
+    // Lettres du texte, codées dans l'ordre des octets.
+    unsigned char seen[256] = {0};
+    for (ptrdiff_t i = 0; i < textLength; i++) {
+        seen[(unsigned char) text[i]] = 1;
+    }
+    packed->alphabetSize = 0;
+    for (int c = 0; c < 256; c++) {
+        packed->codes[c] = -1;
+        if (seen[c]) {
+            // Test d'erreur. Plus de 4 lettres : le texte n'est pas compactable.
+            if (packed->alphabetSize == 4) {
+                return -1;
+            }
+            packed->letters[packed->alphabetSize] = (unsigned char) c;
+            packed->codes[c] = (signed char) packed->alphabetSize;
+            packed->alphabetSize++;
+        }
+    }
+
+    // Compactage. Le mot nul supplémentaire permet de lire la fenêtre qui
+    // commence dans le dernier mot sans test.
+    size_t nbWords = (size_t) (textLength / PACKED_SYMBOLS) + 2;
+    packed->words = calloc(nbWords, sizeof(uint64_t));
+    // Test d'erreur. Si l'allocation a échoué, on renvoie -1.
+    if (packed->words == NULL) {
+        perror("calloc");
+        return -1;
+    }
+    for (ptrdiff_t i = 0; i < textLength; i++) {
+        uint64_t code = (uint64_t) packed->codes[(unsigned char) text[i]];
+        packed->words[i / PACKED_SYMBOLS] |= code << (2 * (i % PACKED_SYMBOLS));
+    }
+    packed->length = textLength;
+    return 0;
+}
+
+/**
+ * Fonction qui reconstruit le texte d'origine à partir du texte compacté.
+ *
+ * @param packed texte compacté.
+ * @param text texte reconstruit (packed->length caractères).
+ */
+void unpackText(struct packedText* packed, char* text) {
+    for (ptrdiff_t i = 0; i < packed->length; i++) {
+        uint64_t code = (packed->words[i / PACKED_SYMBOLS] >> (2 * (i % PACKED_SYMBOLS))) & 3;
+        text[i] = (char) packed->letters[code];
+    }
+}
+
+/**
+ * Fonction qui libère un texte compacté par packText().
+ *
+ * @param packed texte compacté.
+ */
+void freePackedText(struct packedText* packed) {
+    free(packed->words);
+    packed->words = NULL;
+}
+
+/**
+ * Fonction qui renvoie les 32 caractères compactés du texte qui commencent à
+ * la position i.
+ * Le décalage en deux temps de w1 évite un décalage de 64 bits quand i est
+ * un multiple de 32.
+ *
+ * @param words caractères compactés.
+ * @param i position du premier caractère.
+ * @return les 32 caractères, le caractère i dans les bits de poids faible.
+ */
+static inline uint64_t packedWindow(uint64_t* words, ptrdiff_t i) {
+    int s = (int) (i % PACKED_SYMBOLS) * 2;
+    uint64_t w0 = words[i / PACKED_SYMBOLS];
+    uint64_t w1 = words[i / PACKED_SYMBOLS + 1];
+    return (w0 >> s) | ((w1 << (63 - s)) << 1);
+}
+
+/**
+ * Fonction qui renvoie les positions d'un mot de 64 bits dont le caractère
+ * vaut code : le bit 2 * s du résultat est à 1 si le caractère s vaut code.
+ * Les 32 caractères sont comparés en quelques opérations (SWAR) : après le
+ * ou exclusif avec code répété, un caractère égal a ses deux bits nuls.
+ *
+ * @param window 32 caractères compactés.
+ * @param code code du caractère cherché (0 à 3).
+ * @return le masque des caractères égaux à code.
+ */
+static inline uint64_t packedEqual(uint64_t window, uint64_t code) {
+    uint64_t x = window ^ (code * PACKED_LOW_BITS);
+    return ~(x | (x >> 1)) & PACKED_LOW_BITS;
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte
+ * compacté.
+ * Pour chaque mot du texte, les 32 positions qui y commencent sont testées
+ * ensemble : pour chacun des f = min(wordLength, PACKED_FILTER) premiers
+ * caractères j du mot, la fenêtre décalée de j caractères est comparée à
+ * word[j] par packedEqual(), et les masques sont combinés par un et. Il
+ * reste les positions dont les f premiers caractères correspondent, soit f
+ * opérations de mot pour 32 positions au lieu d'une comparaison par
+ * position. Si le mot est plus long que f, la suite est vérifiée à ces
+ * positions seulement, par morceaux de 32 caractères.
+ *
+ * @param packed texte compacté.
+ * @param word mot à rechercher dans le texte.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long packedOccurrences(struct packedText* packed, char* word, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
+    if (packed == NULL || packed->words == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+    // Mot plus long que le texte : aucune occurrence.
+    ptrdiff_t last = packed->length - wordLength;
+    if (last < 0) {
+        return 0;
+    }
+
+    // Compactage du mot : code et masque de chaque morceau de 32 caractères.
+    int nbChunks = (wordLength + PACKED_SYMBOLS - 1) / PACKED_SYMBOLS;
+    uint64_t* pattern = calloc((size_t) (2 * nbChunks), sizeof(uint64_t));
+    // Test d'erreur. Si l'allocation a échoué, on renvoie -2.
+    if (pattern == NULL) {
+        perror("calloc");
+        return -2;
+    }
+    uint64_t* masks = pattern + nbChunks;
+    uint64_t codes[PACKED_FILTER];
+    for (int j = 0; j < wordLength; j++) {
+        int code = packed->codes[(unsigned char) word[j]];
+        // Lettre absente du texte : aucune occurrence.
+        if (code < 0) {
+            free(pattern);
+            return 0;
+        }
+        if (j < PACKED_FILTER) {
+            codes[j] = (uint64_t) code;
+        }
+        pattern[j / PACKED_SYMBOLS] |= (uint64_t) code << (2 * (j % PACKED_SYMBOLS));
+        masks[j / PACKED_SYMBOLS] |= (uint64_t) 3 << (2 * (j % PACKED_SYMBOLS));
+    }
+    int filter = wordLength < PACKED_FILTER ? wordLength : PACKED_FILTER;
+
+    long long count = 0;
+    uint64_t* words = packed->words;
+    // Pour chaque mot du texte, les 32 positions qui y commencent.
+    for (ptrdiff_t k = 0; k * PACKED_SYMBOLS <= last; k++) {
+        uint64_t w0 = words[k];
+        uint64_t w1 = words[k + 1];
+        ptrdiff_t base = k * PACKED_SYMBOLS;
+        // Positions au-delà de last (caractères nuls de fin) écartées.
+        uint64_t candidates = last - base < PACKED_SYMBOLS - 1 ? PACKED_LOW_BITS >> (2 * (PACKED_SYMBOLS - 1 - (last - base))) : PACKED_LOW_BITS;
+        candidates &= packedEqual(w0, codes[0]);
+        for (int j = 1; candidates != 0 && j < filter; j++) {
+            candidates &= packedEqual((w0 >> (2 * j)) | (w1 << (64 - 2 * j)), codes[j]);
+        }
+        while (candidates != 0) {
+            int s = __builtin_ctzll(candidates) / 2;
+            candidates &= candidates - 1;
+            // Suite du mot, par morceaux de 32 caractères.
+            int c = 0;
+            if (wordLength > filter) {
+                while (c < nbChunks && (packedWindow(words, base + s + c * PACKED_SYMBOLS) & masks[c]) == pattern[c]) {
+                    c++;
+                }
+            } else {
+                c = nbChunks;
+            }
+            if (c == nbChunks) {
+                count++;
+                if (report != NULL && report(base + s, data) != 0) {
+                    free(pattern);
+                    return count;
+                }
+            }
+        }
+    }
+
+    free(pattern);
+    return count;
+}
+
+#endif
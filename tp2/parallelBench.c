@@ -0,0 +1,223 @@
+/**
+ * FICHIER:
+ * --------
+ * parallelBench.c
+ *
+ * DESCRIPTION:
+ * ------------
+ * Programme de mesure du passage à l'échelle de parallelOccurrences() et de
+ * parallelCompiledOccurrences() (voir parallelSearch.h).
+ *
+ * Le programme génère en mémoire un texte aléatoire de longueur donnée sur un
+ * alphabet de taille donnée, et des mots aléatoires de longueur donnée. Pour
+ * 1, 2, 4, ... threads, jusqu'au nombre maximal donné, il mesure le temps réel
+ * de la recherche de tous les mots avec l'algorithme choisi (numéro de
+ * exactSearchAlgos.h ; par défaut 23, Horspool optimisé), puis avec Horspool
+ * (10) sur des motifs compilés, dont les tables sont partagées par tous les
+ * threads. Il affiche le débit et l'accélération par rapport à 1 thread.
+ * Les algorithmes à tables précalculées (7, 8, 9, 10, 16 et 17) utilisent
+ * des motifs compilés une fois par mot, hors mesure.
+ *
+ * AUTEUR:
+ * -------
+ * M. TAIA
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+////////////////////////////////////////////////////////////////////////////////
+#include "config.h"
+#include "parallelSearch.h"
+#include "search.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINES
+////////////////////////////////////////////////////////////////////////////////
+// Nombre de mots recherchés pour chaque nombre de threads.
+#define BENCH_WORDS 10
+
+// Algorithme mesuré en plus de l'algorithme choisi (Horspool).
+#define BENCH_HORSPOOL 10
+
+////////////////////////////////////////////////////////////////////////////////
+// Fonctions
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Fonction qui renvoie le temps réel écoulé depuis une origine fixe, en ms.
+ * clock() ne convient pas ici : il cumule le temps CPU de tous les threads.
+ *
+ * @return le temps en ms.
+ */
+double wallTime(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec * 1000 + (double) now.tv_nsec / 1e6;
+}
+
+/**
+ * Fonction qui indique si un algorithme utilise un motif compilé (tables
+ * précalculées, voir compiledOccurrences()).
+ *
+ * @param algoNum numéro de l'algorithme.
+ * @return 1 si l'algorithme utilise un motif compilé, 0 sinon.
+ */
+int usesCompiledPattern(int algoNum) {
+    return algoNum == 7 || algoNum == 8 || algoNum == 9 || algoNum == 10 || algoNum == 16 || algoNum == 17;
+}
+
+/**
+ * Fonction qui mesure le temps réel (en ms) de la recherche de tous les mots
+ * avec nbThreads threads.
+ * Renvoie -1 en cas d'erreur.
+ *
+ * @param algoNum numéro de l'algorithme.
+ * @param text texte dans lequel rechercher les mots.
+ * @param textLength longueur du texte.
+ * @param words mots à rechercher (wordLength + 1 caractères chacun).
+ * @param patterns motifs compilés des mots.
+ * @param wordLength longueur des mots.
+ * @param nbThreads nombre de threads.
+ * @param count nombre total d'occurrences trouvées (résultat).
+ * @return le temps en ms, ou -1 en cas d'erreur.
+ */
+double measureParallel(int algoNum, char* text, int textLength, char* words, struct compiledPattern** patterns, int wordLength, int nbThreads, long long* count) {
+    occurrenceSearch algo = searchAlgorithm(algoNum);
+    *count = 0;
+    double start = wallTime();
+    for (int w = 0; w < BENCH_WORDS; w++) {
+        long long result;
+        if (usesCompiledPattern(algoNum)) {
+            result = parallelCompiledOccurrences(patterns[w], algoNum, text, textLength, nbThreads, NULL, NULL);
+        } else {
+            result = parallelOccurrences(algo, text, words + w * (wordLength + 1), textLength, wordLength, nbThreads, NULL, NULL);
+        }
+        // Test d'erreur. Si la recherche a échoué, on renvoie -1.
+        if (result < 0) {
+            return -1;
+        }
+        *count += result;
+    }
+    return wallTime() - start;
+}
+
+/**
+ * Fonction qui mesure la recherche de tous les mots avec 1, 2, 4, ...
+ * threads, puis maxThreads, et affiche une ligne par mesure.
+ *
+ * @param algoNum numéro de l'algorithme.
+ * @param text texte dans lequel rechercher les mots.
+ * @param textLength longueur du texte.
+ * @param words mots à rechercher (wordLength + 1 caractères chacun).
+ * @param patterns motifs compilés des mots.
+ * @param wordLength longueur des mots.
+ * @param maxThreads nombre maximal de threads.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int measureScaling(int algoNum, char* text, int textLength, char* words, struct compiledPattern** patterns, int wordLength, int maxThreads) {
+    double reference = 0;
+    for (int nbThreads = 1;; nbThreads *= 2) {
+        if (nbThreads > maxThreads) {
+            nbThreads = maxThreads;
+        }
+        long long count = 0;
+        double time = measureParallel(algoNum, text, textLength, words, patterns, wordLength, nbThreads, &count);
+        // Test d'erreur. Si la mesure a échoué, on renvoie -1.
+        if (time < 0) {
+            return -1;
+        }
+        if (nbThreads == 1) {
+            reference = time;
+        }
+        printf("%d, %d, %f, %f, %f, %lld\n", algoNum, nbThreads, time, (double) textLength * BENCH_WORDS / time / 1e6, reference / time, count);
+        if (nbThreads == maxThreads) {
+            return 0;
+        }
+    }
+}
+
+/**
+ * Fonction principale.
+ *
+ * @param argc nombre d'arguments.
+ * @param argv arguments.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int main(int argc, char** argv) {
+    // Test du nombre d'arguments.
+    if (argc != 5 && argc != 6) {
+        printf("Usage : %s textLength alphabetSize wordLength maxThreads [algoNum]\n", argv[0]);
+        return -1;
+    }
+
+    // Récupération des arguments.
+    int textLength = atoi(argv[1]);
+    int alphabetSize = atoi(argv[2]);
+    int wordLength = atoi(argv[3]);
+    int maxThreads = atoi(argv[4]);
+    int algoNum = argc == 6 ? atoi(argv[5]) : 23;
+
+    // Test des arguments
+    if (textLength <= 0) {
+        fprintf(stderr, "La longueur du texte doit être strictement positive.\n");
+        return -1;
+    }
+    if (alphabetSize <= 0 || alphabetSize > MAX_ALPHABET_SIZE) {
+        fprintf(stderr, "La taille de l'alphabet doit être comprise entre 1 et %d.\n", MAX_ALPHABET_SIZE);
+        return -1;
+    }
+    if (wordLength <= 0 || wordLength > MAX_WORD_LENGTH) {
+        fprintf(stderr, "La longueur des mots doit être comprise entre 1 et %d.\n", MAX_WORD_LENGTH);
+        return -1;
+    }
+    if (maxThreads <= 0) {
+        fprintf(stderr, "Le nombre de threads doit être strictement positif.\n");
+        return -1;
+    }
+    if (searchAlgorithm(algoNum) == NULL && !usesCompiledPattern(algoNum)) {
+        fprintf(stderr, "L'algorithme %d ne peut pas être utilisé en parallèle.\n", algoNum);
+        return -1;
+    }
+
+    // Génération du texte et des mots (mêmes lettres que les générateurs).
+    char* text = malloc((size_t) textLength);
+    char* words = malloc(BENCH_WORDS * (size_t) (wordLength + 1));
+    struct compiledPattern* patterns[BENCH_WORDS] = {NULL};
+    int err = text == NULL || words == NULL;
+    for (int i = 0; !err && i < textLength; i++) {
+        text[i] = (char) (rand() % alphabetSize + '!');
+    }
+    for (int i = 0; !err && i < BENCH_WORDS * (wordLength + 1); i++) {
+        words[i] = (i + 1) % (wordLength + 1) == 0 ? '\0' : (char) (rand() % alphabetSize + '!');
+    }
+    // Motifs compilés, hors mesure.
+    for (int w = 0; !err && w < BENCH_WORDS; w++) {
+        patterns[w] = compilePattern(words + w * (wordLength + 1), wordLength);
+        err = patterns[w] == NULL;
+    }
+    // Test d'erreur. Si une allocation a échoué, on renvoie -1.
+    if (err) {
+        fprintf(stderr, "Erreur lors de l'allocation.\n");
+    }
+
+    // Mesures de l'algorithme choisi, puis de Horspool.
+    if (!err) {
+        printf("algorithme, threads, temps (ms), débit (Go/s), accélération, occurrences\n");
+        err = measureScaling(algoNum, text, textLength, words, patterns, wordLength, maxThreads) == -1
+              || (algoNum != BENCH_HORSPOOL && measureScaling(BENCH_HORSPOOL, text, textLength, words, patterns, wordLength, maxThreads) == -1);
+        if (err) {
+            fprintf(stderr, "Erreur lors de la recherche.\n");
+        }
+    }
+
+    for (int w = 0; w < BENCH_WORDS; w++) {
+        freePattern(patterns[w]);
+    }
+    free(text);
+    free(words);
+    return err ? -1 : 0;
+}
@@ -0,0 +1,269 @@
+/**
+ * FICHIER:
+ * --------
+ * parallelSearch.h
+ *
+ * DESCRIPTION:
+ * ------------
+ * Ce fichier contient un pilote de recherche parallèle pour les algorithmes
+ * de exactSearchAlgos.h : le texte est découpé en morceaux, un par thread,
+ * qui se recouvrent de wordLength - 1 caractères. Chaque thread recherche le
+ * mot dans son morceau, puis les occurrences sont fusionnées dans l'ordre du
+ * texte.
+ *
+ * parallelCompiledOccurrences() fait de même avec un motif compilé
+ * (compilePattern()) : ses tables, calculées une fois, sont partagées en
+ * lecture par tous les threads.
+ *
+ * Le morceau i est responsable des occurrences qui commencent dans
+ * [start_i, start_{i+1}[ : il s'étend jusqu'à start_{i+1} + wordLength - 1,
+ * si bien qu'une occurrence à cheval sur deux morceaux est trouvée une fois,
+ * par le premier, et jamais en double.
+ *
+ * AUTEUR:
+ * -------
+ * M. TAIA
+ */
+
+#ifndef PARALLEL_SEARCH_H
+#define PARALLEL_SEARCH_H
+
+////////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+////////////////////////////////////////////////////////////////////////////////
+#include "exactSearchAlgos.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Liste d'occurrences de taille variable, remplie par appendOccurrence().
+ */
+struct occurrenceList {
+    ptrdiff_t* indices; // Indices des occurrences
+    ptrdiff_t capacity; // Taille allouée de indices
+    ptrdiff_t count; // Nombre d'indices stockés
+    int failed; // 1 si une réallocation a échoué
+};
+
+/**
+ * Morceau de texte confié à un thread, et son résultat.
+ */
+struct searchChunk {
+    occurrenceSearch algo; // Algorithme sans table (ou NULL)
+    struct compiledPattern* pattern; // Motif compilé, si algo est NULL
+    int algoNum; // Algorithme du motif compilé
+    char* text; // Début du morceau
+    char* word;
+    ptrdiff_t length; // Longueur du morceau (recouvrement compris)
+    int wordLength;
+    int collect; // 1 pour stocker les occurrences, 0 pour les compter
+    struct occurrenceList list;
+    long long count; // Résultat de l'algorithme
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Fonctions
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Fonction appelée pour chaque occurrence d'un morceau : ajoute l'indice à la
+ * liste, en doublant sa taille si besoin.
+ *
+ * @param index indice de l'occurrence dans le morceau.
+ * @param data liste d'occurrences (struct occurrenceList*).
+ * @return 0 pour continuer, 1 pour arrêter si la réallocation a échoué.
+ */
+int appendOccurrence(ptrdiff_t index, void* data) {
+    struct occurrenceList* list = (struct occurrenceList*) data;
+    if (list->count == list->capacity) {
+        ptrdiff_t capacity = list->capacity == 0 ? 64 : 2 * list->capacity;
+        ptrdiff_t* indices = realloc(list->indices, sizeof(ptrdiff_t) * (size_t) capacity);
+        if (indices == NULL) {
+            perror("realloc");
+            list->failed = 1;
+            return 1;
+        }
+        list->indices = indices;
+        list->capacity = capacity;
+    }
+    list->indices[list->count++] = index;
+    return 0;
+}
+
+/**
+ * Fonction exécutée par chaque thread : recherche le mot dans son morceau.
+ *
+ * @param arg morceau (struct searchChunk*).
+ * @return NULL.
+ */
+void* searchChunkThread(void* arg) {
+    struct searchChunk* chunk = (struct searchChunk*) arg;
+    occurrenceCallback report = chunk->collect ? &appendOccurrence : NULL;
+    void* data = chunk->collect ? &chunk->list : NULL;
+    if (chunk->algo == NULL) {
+        chunk->count = compiledOccurrences(chunk->pattern, chunk->algoNum, chunk->text, chunk->length, report, data);
+    } else {
+        chunk->count = chunk->algo(chunk->text, chunk->word, chunk->length, chunk->wordLength, report, data);
+    }
+    return NULL;
+}
+
+/**
+ * Fonction qui découpe le texte en nbThreads morceaux, les fait traiter par
+ * autant de threads selon le modèle model (algorithme et mot), puis transmet
+ * les occurrences à report dans l'ordre croissant des indices.
+ * Si un thread ne peut pas être créé, son morceau est traité par le thread
+ * appelant.
+ *
+ * @param model morceau modèle : algo, pattern, algoNum, word et wordLength.
+ * @param text texte dans lequel rechercher le mot.
+ * @param textLength longueur du texte.
+ * @param nbThreads nombre de threads.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long parallelChunks(struct searchChunk* model, char* text, ptrdiff_t textLength, int nbThreads, occurrenceCallback report, void* data) {
+    int wordLength = model->wordLength;
+    // Nombre de positions de départ possibles.
+    ptrdiff_t positions = textLength - wordLength + 1;
+    if (positions <= 0) {
+        return 0;
+    }
+    if (nbThreads > positions) {
+        nbThreads = (int) positions;
+    }
+
+    struct searchChunk* chunks = calloc((size_t) nbThreads, sizeof(struct searchChunk));
+    pthread_t* threads = malloc(sizeof(pthread_t) * (size_t) nbThreads);
+    int* started = calloc((size_t) nbThreads, sizeof(int));
+    // Test d'erreur. Si une allocation a échoué, on renvoie -2.
+    if (chunks == NULL || threads == NULL || started == NULL) {
+        perror("malloc");
+        free(chunks);
+        free(threads);
+        free(started);
+        return -2;
+    }
+
+    // Découpage et lancement des threads. Le morceau 0 est traité par le
+    // thread appelant.
+    for (int t = 0; t < nbThreads; t++) {
+        ptrdiff_t start = positions / nbThreads * t + positions % nbThreads * t / nbThreads;
+        ptrdiff_t end = positions / nbThreads * (t + 1) + positions % nbThreads * (t + 1) / nbThreads;
+        chunks[t] = *model;
+        chunks[t].text = text + start;
+        chunks[t].length = end - start + wordLength - 1;
+        chunks[t].collect = report != NULL;
+        if (t > 0) {
+            started[t] = pthread_create(&threads[t], NULL, &searchChunkThread, &chunks[t]) == 0;
+        }
+    }
+    searchChunkThread(&chunks[0]);
+    for (int t = 1; t < nbThreads; t++) {
+        if (started[t]) {
+            pthread_join(threads[t], NULL);
+        } else {
+            searchChunkThread(&chunks[t]);
+        }
+    }
+
+    // Fusion des résultats, dans l'ordre des morceaux.
+    long long count = 0;
+    int stop = 0;
+    for (int t = 0; t < nbThreads; t++) {
+        if (chunks[t].count < 0 || chunks[t].list.failed) {
+            count = -2;
+        }
+        if (count >= 0 && !stop) {
+            if (report == NULL) {
+                count += chunks[t].count;
+            }
+            for (ptrdiff_t k = 0; report != NULL && !stop && k < chunks[t].list.count; k++) {
+                count++;
+                stop = report((chunks[t].text - text) + chunks[t].list.indices[k], data) != 0;
+            }
+        }
+        free(chunks[t].list.indices);
+    }
+
+    free(chunks);
+    free(threads);
+    free(started);
+    return count;
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte avec
+ * l'algorithme algo, réparti sur nbThreads threads.
+ * Les occurrences sont transmises à report dans l'ordre croissant des
+ * indices, depuis le thread appelant, une fois tous les morceaux traités.
+ * Les algorithmes qui écrivent une sentinelle dans le texte (3 et 6) sont
+ * refusés : la sentinelle d'un morceau serait dans le morceau suivant.
+ * Pour les algorithmes à tables précalculées, voir
+ * parallelCompiledOccurrences().
+ *
+ * @param algo algorithme de recherche (sans table précalculée).
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param nbThreads nombre de threads.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long parallelOccurrences(occurrenceSearch algo, char* text, char* word, ptrdiff_t textLength, int wordLength, int nbThreads, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si un paramètre est invalide, on renvoie -2.
+    if (algo == NULL || text == NULL || word == NULL || wordLength <= 0 || nbThreads <= 0) {
+        return -2;
+    }
+    if (algo == &naifSentinelleOccurrences || algo == &naifSentinelleStrncmpOccurrences) {
+        return -2;
+    }
+    struct searchChunk model = {0};
+    model.algo = algo;
+    model.word = word;
+    model.wordLength = wordLength;
+    return parallelChunks(&model, text, textLength, nbThreads, report, data);
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un motif compilé dans un
+ * texte avec l'algorithme algoNum (voir compiledOccurrences()), réparti sur
+ * nbThreads threads. Les tables du motif ne sont calculées qu'une fois, par
+ * compilePattern(), et lues par tous les threads.
+ *
+ * @param pattern motif compilé.
+ * @param algoNum numéro de l'algorithme (7, 8, 9, 10, 16 ou 17).
+ * @param text texte dans lequel rechercher le motif.
+ * @param textLength longueur du texte.
+ * @param nbThreads nombre de threads.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long parallelCompiledOccurrences(struct compiledPattern* pattern, int algoNum, char* text, ptrdiff_t textLength, int nbThreads, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si un paramètre est invalide, on renvoie -2.
+    if (pattern == NULL || text == NULL || nbThreads <= 0) {
+        return -2;
+    }
+    // Test d'erreur. Si l'algorithme n'utilise pas de motif compilé, on
+    // renvoie -2.
+    if (algoNum != 7 && algoNum != 8 && algoNum != 9 && algoNum != 10 && algoNum != 16 && algoNum != 17) {
+        return -2;
+    }
+    struct searchChunk model = {0};
+    model.pattern = pattern;
+    model.algoNum = algoNum;
+    model.word = pattern->word;
+    model.wordLength = pattern->wordLength;
+    return parallelChunks(&model, text, textLength, nbThreads, report, data);
+}
+
+#endif
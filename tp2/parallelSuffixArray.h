@@ -0,0 +1,427 @@
+/**
+ * FICHIER:
+ * --------
+ * parallelSuffixArray.h
+ *
+ * DESCRIPTION:
+ * ------------
+ * Ce fichier contient la construction du tableau des suffixes avec plusieurs
+ * threads (POSIX), par doublement des préfixes (Manber et Myers) :
+ *
+ * - au départ, le rang de chaque suffixe est son premier caractère ;
+ * - à chaque tour, les suffixes sont triés selon le couple (rang du suffixe
+ *   i, rang du suffixe i + k), qui ordonne leurs préfixes de longueur 2k, puis
+ *   renumérotés : deux suffixes ont le même rang si leurs couples sont égaux ;
+ * - on s'arrête quand tous les rangs sont distincts (environ log2 du plus
+ *   long facteur répété tours).
+ *
+ * Le tri est un tri par base (8 bits par passe, poids faibles d'abord) des
+ * couples : les chiffres du deuxième rang, puis ceux du premier. Les deux
+ * rangs restent dans deux tableaux, sans être codés dans un seul entier : les
+ * textes de plus de 2^32 caractères (SUFFIX_ARRAY_64) sont triés sans
+ * débordement. Chaque passe est partagée entre les threads :
+ * chacun compte les chiffres de sa tranche, les débuts de seaux sont calculés
+ * pour chaque (chiffre, thread), puis chacun range sa tranche, ce qui garde le
+ * tri stable. La renumérotation est aussi partagée (comptage des changements
+ * de couple par tranche, puis écriture des rangs).
+ *
+ * Les threads sont créés une seule fois pour toute la construction. Le thread
+ * appelant traite la première tranche ; à chaque étape, tous les threads se
+ * retrouvent à une barrière (pthread_barrier_t) avant l'étape, puis après :
+ * un tour ne coûte que deux barrières par étape, au lieu d'une création et
+ * d'une attente de chaque thread.
+ *
+ * Le résultat est identique à celui de suffixArrayOf() (suffixArray.h), qui
+ * reste plus rapide avec un seul thread. La mémoire utilisée est de 7 saIndex
+ * par caractère, soit 28 octets (56 avec SUFFIX_ARRAY_64) : couples, indices
+ * et rangs, avec les copies du tri.
+ *
+ * AUTEUR:
+ * -------
+ * M. TAIA
+ */
+
+#ifndef PARALLEL_SUFFIX_ARRAY_H
+#define PARALLEL_SUFFIX_ARRAY_H
+
+////////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+////////////////////////////////////////////////////////////////////////////////
+#include "suffixArray.h"
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINES
+////////////////////////////////////////////////////////////////////////////////
+// Nombre de bits du chiffre de chaque passe du tri par base.
+#define RADIX_BITS 8
+#define RADIX_SIZE (1 << RADIX_BITS)
+
+// Étapes d'un tour, exécutées par chaque thread sur sa tranche.
+#define PSA_KEYS 0
+#define PSA_COUNT 1
+#define PSA_SCATTER 2
+#define PSA_GROUPS 3
+#define PSA_RANKS 4
+// Fin de la construction : les threads se terminent.
+#define PSA_STOP 5
+
+////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Données partagées par les threads de la construction.
+ */
+struct psaShared {
+    char* text;
+    ptrdiff_t n; // Longueur du texte
+    int nbThreads;
+    saIndex* first; // Rang du suffixe de chaque case
+    saIndex* second; // Rang du suffixe i + k (0 au-delà du texte)
+    saIndex* firstTmp;
+    saIndex* secondTmp;
+    saIndex* sa;
+    saIndex* saTmp;
+    saIndex* rank; // Rang de chaque suffixe (0 pour le suffixe vide)
+    ptrdiff_t* buckets; // RADIX_SIZE compteurs par thread
+    ptrdiff_t* groups; // Nombre de changements de couple par tranche
+    ptrdiff_t k; // Décalage du deuxième rang
+    saIndex* digits; // Rangs dont la passe trie un chiffre (first ou second)
+    int shift; // Décalage du chiffre de la passe
+    int step; // Étape à exécuter
+    struct psaWorker* workers; // Arguments des threads
+    struct psaPool* pool;
+};
+
+/**
+ * Threads de la construction, autres que le thread appelant (numéro 0).
+ */
+struct psaPool {
+    pthread_t* threads; // Threads 1 à nbThreads - 1
+    int started; // Nombre de threads démarrés
+    int ready; // 1 si la barrière est prête (lu sous gate)
+    pthread_barrier_t barrier; // Début et fin de chaque étape
+    pthread_mutex_t gate; // Tenu pendant le démarrage des threads
+};
+
+/**
+ * Argument d'un thread : les données partagées et son numéro.
+ */
+struct psaWorker {
+    struct psaShared* shared;
+    int id;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Fonctions
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Fonction exécutée par un thread : l'étape shared->step sur sa tranche
+ * [id * n / nbThreads, (id + 1) * n / nbThreads[.
+ *
+ * @param arg argument du thread (struct psaWorker*).
+ * @return NULL.
+ */
+void* psaStep(void* arg) {
+    struct psaWorker* worker = (struct psaWorker*) arg;
+    struct psaShared* s = worker->shared;
+    ptrdiff_t start = s->n / s->nbThreads * worker->id + s->n % s->nbThreads * worker->id / s->nbThreads;
+    ptrdiff_t end = s->n / s->nbThreads * (worker->id + 1) + s->n % s->nbThreads * (worker->id + 1) / s->nbThreads;
+    ptrdiff_t* buckets = s->buckets + (ptrdiff_t) worker->id * RADIX_SIZE;
+
+    switch (s->step) {
+        case PSA_KEYS:
+            // Couples des suffixes, dans l'ordre du texte.
+            for (ptrdiff_t i = start; i < end; i++) {
+                s->first[i] = s->rank[i];
+                s->second[i] = i + s->k < s->n ? s->rank[i + s->k] : 0;
+                s->sa[i] = (saIndex) i;
+            }
+            break;
+        case PSA_COUNT:
+            // Nombre de couples de la tranche pour chaque chiffre.
+            memset(buckets, 0, sizeof(ptrdiff_t) * RADIX_SIZE);
+            for (ptrdiff_t i = start; i < end; i++) {
+                buckets[((uint64_t) s->digits[i] >> s->shift) & (RADIX_SIZE - 1)]++;
+            }
+            break;
+        case PSA_SCATTER:
+            // Rangement de la tranche, à partir des débuts de seaux du thread.
+            for (ptrdiff_t i = start; i < end; i++) {
+                ptrdiff_t dest = buckets[((uint64_t) s->digits[i] >> s->shift) & (RADIX_SIZE - 1)]++;
+                s->firstTmp[dest] = s->first[i];
+                s->secondTmp[dest] = s->second[i];
+                s->saTmp[dest] = s->sa[i];
+            }
+            break;
+        case PSA_GROUPS:
+            // Nombre de couples de la tranche différents du précédent.
+            s->groups[worker->id] = 0;
+            for (ptrdiff_t i = start; i < end; i++) {
+                if (i == 0 || s->first[i] != s->first[i - 1] || s->second[i] != s->second[i - 1]) {
+                    s->groups[worker->id]++;
+                }
+            }
+            break;
+        case PSA_RANKS:
+            // Nouveaux rangs : numéro du groupe de couples égaux (à partir de 1).
+            {
+                ptrdiff_t group = s->groups[worker->id];
+                for (ptrdiff_t i = start; i < end; i++) {
+                    if (i == 0 || s->first[i] != s->first[i - 1] || s->second[i] != s->second[i - 1]) {
+                        group++;
+                    }
+                    s->rank[s->sa[i]] = (saIndex) group;
+                }
+            }
+            break;
+    }
+    return NULL;
+}
+
+/**
+ * Fonction exécutée par les threads 1 à nbThreads - 1 pendant toute la
+ * construction : à chaque étape, le thread attend à la barrière que le thread
+ * appelant ait fixé shared->step, exécute l'étape sur sa tranche, puis attend
+ * à la barrière que toutes les tranches soient traitées.
+ *
+ * @param arg argument du thread (struct psaWorker*).
+ * @return NULL.
+ */
+void* psaLoop(void* arg) {
+    struct psaWorker* worker = (struct psaWorker*) arg;
+    struct psaShared* s = worker->shared;
+    // Attente de la fin du démarrage, qui dit si la barrière est prête.
+    pthread_mutex_lock(&s->pool->gate);
+    int ready = s->pool->ready;
+    pthread_mutex_unlock(&s->pool->gate);
+    if (!ready) {
+        return NULL;
+    }
+    for (;;) {
+        pthread_barrier_wait(&s->pool->barrier);
+        if (s->step == PSA_STOP) {
+            return NULL;
+        }
+        psaStep(worker);
+        pthread_barrier_wait(&s->pool->barrier);
+    }
+}
+
+/**
+ * Fonction qui démarre les threads 1 à shared->nbThreads - 1. Si un thread ou
+ * la barrière ne peut pas être créé, la construction continue avec les
+ * threads déjà démarrés (shared->nbThreads est diminué, et vaut 1 sans
+ * barrière) : le résultat est le même.
+ *
+ * @param shared données partagées (shared->workers déjà initialisés).
+ * @param pool threads à démarrer.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int psaStartPool(struct psaShared* shared, struct psaPool* pool) {
+    shared->pool = pool;
+    pool->started = 0;
+    pool->ready = 0;
+    pool->threads = malloc(sizeof(pthread_t) * (size_t) shared->nbThreads);
+    // Test d'erreur. Si l'allocation a échoué, on renvoie -1.
+    if (pool->threads == NULL || pthread_mutex_init(&pool->gate, NULL) != 0) {
+        perror("psaStartPool");
+        free(pool->threads);
+        pool->threads = NULL;
+        return -1;
+    }
+    pthread_mutex_lock(&pool->gate);
+    for (int t = 1; t < shared->nbThreads; t++) {
+        if (pthread_create(&pool->threads[t], NULL, &psaLoop, &shared->workers[t]) != 0) {
+            break;
+        }
+        pool->started++;
+    }
+    pool->ready = pool->started > 0 && pthread_barrier_init(&pool->barrier, NULL, (unsigned) pool->started + 1) == 0;
+    if (pool->started > 0 && !pool->ready) {
+        // Pas de barrière : les threads démarrés se terminent aussitôt.
+        pthread_mutex_unlock(&pool->gate);
+        for (int t = 1; t <= pool->started; t++) {
+            pthread_join(pool->threads[t], NULL);
+        }
+        pool->started = 0;
+    } else {
+        pthread_mutex_unlock(&pool->gate);
+    }
+    shared->nbThreads = pool->started + 1;
+    return 0;
+}
+
+/**
+ * Fonction qui termine les threads démarrés par psaStartPool().
+ *
+ * @param shared données partagées.
+ */
+void psaStopPool(struct psaShared* shared) {
+    struct psaPool* pool = shared->pool;
+    if (pool->started > 0) {
+        shared->step = PSA_STOP;
+        pthread_barrier_wait(&pool->barrier);
+        for (int t = 1; t <= pool->started; t++) {
+            pthread_join(pool->threads[t], NULL);
+        }
+        pthread_barrier_destroy(&pool->barrier);
+    }
+    pthread_mutex_destroy(&pool->gate);
+    free(pool->threads);
+}
+
+/**
+ * Fonction qui exécute une étape sur toutes les tranches : le thread appelant
+ * traite la première, les threads de shared->pool les autres.
+ *
+ * @param shared données partagées (threads démarrés par psaStartPool()).
+ * @param step étape à exécuter.
+ */
+void psaRun(struct psaShared* shared, int step) {
+    shared->step = step;
+    if (shared->pool->started > 0) {
+        pthread_barrier_wait(&shared->pool->barrier);
+    }
+    psaStep(&shared->workers[0]);
+    if (shared->pool->started > 0) {
+        pthread_barrier_wait(&shared->pool->barrier);
+    }
+}
+
+/**
+ * Fonction qui trie les cases par base selon un chiffre de 8 bits de digits
+ * (first ou second), de shift = 0 jusqu'au dernier chiffre non nul de
+ * maxRank. Chaque passe échange les tableaux et leurs copies.
+ *
+ * @param s données partagées.
+ * @param second 1 pour trier selon second, 0 pour first.
+ * @param maxRank plus grand rang du tableau trié.
+ */
+void psaSortBy(struct psaShared* s, int second, uint64_t maxRank) {
+    for (s->shift = 0; s->shift < 64 && (maxRank >> s->shift) > 0; s->shift += RADIX_BITS) {
+        s->digits = second ? s->second : s->first;
+        psaRun(s, PSA_COUNT);
+        // Débuts de seaux, pour chaque chiffre puis chaque thread.
+        ptrdiff_t sum = 0;
+        for (int d = 0; d < RADIX_SIZE; d++) {
+            for (int t = 0; t < s->nbThreads; t++) {
+                ptrdiff_t count = s->buckets[t * RADIX_SIZE + d];
+                s->buckets[t * RADIX_SIZE + d] = sum;
+                sum += count;
+            }
+        }
+        psaRun(s, PSA_SCATTER);
+        saIndex* swap = s->first;
+        s->first = s->firstTmp;
+        s->firstTmp = swap;
+        swap = s->second;
+        s->second = s->secondTmp;
+        s->secondTmp = swap;
+        swap = s->sa;
+        s->sa = s->saTmp;
+        s->saTmp = swap;
+    }
+}
+
+/**
+ * Fonction qui construit le tableau des suffixes d'un texte avec nbThreads
+ * threads, par doublement des préfixes.
+ *
+ * @param text texte.
+ * @param textLength longueur du texte (au plus SA_INDEX_MAX - 1).
+ * @param nbThreads nombre de threads (au moins 1).
+ * @return le tableau des suffixes (textLength cases, à libérer par free()),
+ *         identique à celui de suffixArrayOf(), ou NULL en cas d'erreur.
+ */
+saIndex* parallelSuffixArrayOf(char* text, ptrdiff_t textLength, int nbThreads) {
+    // Test d'erreur. Si le texte est NULL ou trop long, on renvoie NULL.
+    if (text == NULL || textLength < 0 || textLength >= SA_INDEX_MAX || nbThreads < 1) {
+        return NULL;
+    }
+    ptrdiff_t n = textLength;
+    // Pas plus de threads que de caractères.
+    if (nbThreads > n) {
+        nbThreads = n > 0 ? (int) n : 1;
+    }
+    size_t cells = (size_t) n + 1;
+    struct psaShared s = {text, n, nbThreads, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0, NULL, 0, 0, NULL, NULL};
+    s.first = malloc(sizeof(saIndex) * cells);
+    s.second = malloc(sizeof(saIndex) * cells);
+    s.firstTmp = malloc(sizeof(saIndex) * cells);
+    s.secondTmp = malloc(sizeof(saIndex) * cells);
+    s.sa = malloc(sizeof(saIndex) * cells);
+    s.saTmp = malloc(sizeof(saIndex) * cells);
+    s.rank = malloc(sizeof(saIndex) * cells);
+    s.buckets = malloc(sizeof(ptrdiff_t) * RADIX_SIZE * (size_t) nbThreads);
+    s.groups = malloc(sizeof(ptrdiff_t) * (size_t) nbThreads);
+    s.workers = malloc(sizeof(struct psaWorker) * (size_t) nbThreads);
+    struct psaPool pool;
+    int err = 0;
+    // Test d'erreur. Si une allocation a échoué, on renvoie NULL.
+    if (s.first == NULL || s.second == NULL || s.firstTmp == NULL || s.secondTmp == NULL || s.sa == NULL || s.saTmp == NULL
+        || s.rank == NULL || s.buckets == NULL || s.groups == NULL || s.workers == NULL) {
+        perror("malloc");
+        err = -1;
+    }
+    for (int t = 0; err == 0 && t < nbThreads; t++) {
+        s.workers[t].shared = &s;
+        s.workers[t].id = t;
+    }
+    if (err == 0) {
+        err = psaStartPool(&s, &pool);
+    }
+
+    // Rangs initiaux : premier caractère (1 à 256).
+    uint64_t maxRank = 256;
+    for (ptrdiff_t i = 0; err == 0 && i < n; i++) {
+        s.rank[i] = (saIndex) ((unsigned char) text[i]) + 1;
+    }
+    for (s.k = 1; err == 0 && n > 0; s.k *= 2) {
+        // Couples (rang, rang du suffixe i + k), puis tri par base stable :
+        // deuxième rang d'abord, premier rang ensuite.
+        psaRun(&s, PSA_KEYS);
+        psaSortBy(&s, 1, maxRank);
+        psaSortBy(&s, 0, maxRank);
+        // Renumérotation.
+        psaRun(&s, PSA_GROUPS);
+        ptrdiff_t groups = 0;
+        for (int t = 0; t < s.nbThreads; t++) {
+            ptrdiff_t count = s.groups[t];
+            s.groups[t] = groups;
+            groups += count;
+        }
+        psaRun(&s, PSA_RANKS);
+        maxRank = (uint64_t) groups;
+        // Tous les rangs sont distincts : les suffixes sont triés.
+        if (groups == n) {
+            break;
+        }
+    }
+    if (err == 0) {
+        psaStopPool(&s);
+    }
+
+    free(s.first);
+    free(s.second);
+    free(s.firstTmp);
+    free(s.secondTmp);
+    free(s.saTmp);
+    free(s.rank);
+    free(s.buckets);
+    free(s.groups);
+    free(s.workers);
+    if (err != 0) {
+        free(s.sa);
+        return NULL;
+    }
+    return s.sa;
+}
+
+#endif
@@ -18,9 +18,28 @@ subplot_titles_list = [
     "MP",
     "KMP",
     "Boyer-Moore",
-    "Horspool"
+    "Horspool",
+    "Naïf vectorisé (SSE2/AVX2)",
+    "Two-Way",
+    "Shift-Or",
+    "BNDM",
+    "BOM",
+    "Turbo-BM",
+    "Apostolico-Giancarlo",
+    "Karp-Rabin",
+    "Multi-motifs Karp-Rabin (par mot)",
+    "Wu-Manber (par mot)",
+    "Quick Search (Sunday)",
+    "Raita",
+    "Horspool optimisé",
+    "search() (choix automatique)",
+    "Tableau des suffixes (construction comprise)",
+    "Index FM (construction comprise)"
 ]
 
+# Nombre de lignes de subplots (3 colonnes)
+nb_rows = (len(subplot_titles_list) + 2) // 3
+
 # Mapper depuis le numéro de l'algorithme à la position du subplot
 subplot_map = {}
 for i in range(1, len(subplot_titles_list) + 1):
@@ -31,7 +50,7 @@ alphabet_sizes = [2, 4, 20, 70]
 
 # Créer un subplot
 fig = make_subplots(
-    rows=4,
+    rows=nb_rows,
     cols=3,
     subplot_titles=subplot_titles_list,
     # x_title="Alphabet size",
@@ -76,7 +95,7 @@ fig.show()
 
 # Créer un subplot
 fig2 = make_subplots(
-    rows=3,
+    rows=nb_rows,
     cols=3,
     subplot_titles=subplot_titles_list,
     # x_title="Alphabet size",
@@ -84,7 +103,7 @@ fig2 = make_subplots(
 )
 
 # Itérer sur les numéros d'algorithme
-for algo_num in range(1, len(subplot_titles_list)):
+for algo_num in range(1, len(subplot_titles_list) + 1):
     # Créer un subplot pour ce numéro d'algorithme
     subplot = subplot_map[int(algo_num)]
 
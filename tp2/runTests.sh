@@ -13,7 +13,7 @@ word_lengths=(4 5 6 7 8 9 10 15 20 30 40 50)
 list_length=100
 
 # La liste des numéros d'algorithmes à utiliser
-algo_nums=(1 2 3 4 5 6 7 8 9 10 11)
+algo_nums=(1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25 26)
 
 # Le nom du répertoire de sortie
 output_dir="output"
@@ -0,0 +1,205 @@
+/**
+ * FICHIER:
+ * --------
+ * saBench.c
+ *
+ * DESCRIPTION:
+ * ------------
+ * Programme de mesure de la construction du tableau des suffixes : SA-IS
+ * (suffixArrayOf(), suffixArray.h), puis le doublement des préfixes avec 1,
+ * 2, 4, ... threads, jusqu'au nombre maximal donné (parallelSuffixArrayOf(),
+ * parallelSuffixArray.h).
+ *
+ * Chaque construction se fait dans un processus fils, qui projette le texte
+ * en mémoire : le pic de mémoire résidente (getrusage) est celui de cette
+ * seule construction. Le fils renvoie le temps réel de la construction et
+ * une empreinte du tableau obtenu, comparée à celle de SA-IS.
+ *
+ * Exemple :
+ *   ./singleStringText_generator 1000000 4 saBench_text.txt
+ *   ./saBench saBench_text.txt 16
+ *
+ * AUTEUR:
+ * -------
+ * M. TAIA
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+////////////////////////////////////////////////////////////////////////////////
+#include "mappedText.h"
+#include "parallelSuffixArray.h"
+#include "suffixArray.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Résultat d'une construction, transmis par le processus fils.
+ */
+struct buildResult {
+    double time; // Temps réel (ms)
+    uint64_t hash; // Empreinte du tableau des suffixes
+    int ok; // 1 si la construction a réussi
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Fonctions
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Fonction qui renvoie le temps réel écoulé depuis une origine fixe, en ms.
+ *
+ * @return le temps en ms.
+ */
+double wallTime(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec * 1000 + (double) now.tv_nsec / 1e6;
+}
+
+/**
+ * Fonction qui calcule l'empreinte (FNV-1a sur 64 bits) d'un tableau des
+ * suffixes.
+ *
+ * @param sa tableau des suffixes.
+ * @param length nombre de cases.
+ * @return l'empreinte.
+ */
+uint64_t hashSuffixArray(saIndex* sa, ptrdiff_t length) {
+    uint64_t hash = UINT64_C(14695981039346656037);
+    for (ptrdiff_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint64_t) sa[i]) * UINT64_C(1099511628211);
+    }
+    return hash;
+}
+
+/**
+ * Fonction qui construit le tableau des suffixes du fichier filename dans un
+ * processus fils, avec SA-IS (nbThreads = 0) ou le doublement des préfixes.
+ *
+ * @param filename nom du fichier texte.
+ * @param nbThreads nombre de threads (0 pour SA-IS).
+ * @param result résultat de la construction.
+ * @param peakKb pic de mémoire résidente du fils, en Ko (résultat).
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int measureBuild(char* filename, int nbThreads, struct buildResult* result, long* peakKb) {
+    int fds[2];
+    // Test d'erreur. Si la création du tube a échoué, on renvoie -1.
+    if (pipe(fds) == -1) {
+        perror("pipe");
+        return -1;
+    }
+    pid_t pid = fork();
+    // Test d'erreur. Si la création du fils a échoué, on renvoie -1.
+    if (pid == -1) {
+        perror("fork");
+        close(fds[0]);
+        close(fds[1]);
+        return -1;
+    }
+
+    if (pid == 0) {
+        // Fils : construction et envoi du résultat.
+        close(fds[0]);
+        struct buildResult child = {0, 0, 0};
+        struct mappedText mapped;
+        if (mapText(filename, 0, 0, &mapped) == 0) {
+            double start = wallTime();
+            saIndex* sa = nbThreads == 0 ? suffixArrayOf(mapped.text, (ptrdiff_t) mapped.length)
+                                         : parallelSuffixArrayOf(mapped.text, (ptrdiff_t) mapped.length, nbThreads);
+            child.time = wallTime() - start;
+            if (sa != NULL) {
+                child.hash = hashSuffixArray(sa, (ptrdiff_t) mapped.length);
+                child.ok = 1;
+                free(sa);
+            }
+            unmapText(&mapped);
+        }
+        ssize_t written = write(fds[1], &child, sizeof(child));
+        close(fds[1]);
+        _exit(written == (ssize_t) sizeof(child) ? 0 : 1);
+    }
+
+    // Père : lecture du résultat et de la mémoire du fils.
+    close(fds[1]);
+    ssize_t length = read(fds[0], result, sizeof(*result));
+    close(fds[0]);
+    int status;
+    struct rusage usage;
+    if (wait4(pid, &status, 0, &usage) == -1) {
+        perror("wait4");
+        return -1;
+    }
+    *peakKb = usage.ru_maxrss;
+    // Test d'erreur. Si le fils a échoué, on renvoie -1.
+    if (length != (ssize_t) sizeof(*result) || !WIFEXITED(status) || WEXITSTATUS(status) != 0 || !result->ok) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Fonction principale.
+ *
+ * @param argc nombre d'arguments.
+ * @param argv arguments.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int main(int argc, char** argv) {
+    // Test du nombre d'arguments.
+    if (argc != 3) {
+        printf("Usage : %s textFilename maxThreads\n", argv[0]);
+        return -1;
+    }
+
+    // Récupération des arguments.
+    char* filename = argv[1];
+    int maxThreads = atoi(argv[2]);
+
+    // Test des arguments
+    if (maxThreads <= 0) {
+        fprintf(stderr, "Le nombre de threads doit être strictement positif.\n");
+        return -1;
+    }
+
+    // Référence : SA-IS.
+    printf("construction, threads, temps (ms), mémoire max (Mo), identique\n");
+    struct buildResult reference;
+    long peakKb;
+    if (measureBuild(filename, 0, &reference, &peakKb) == -1) {
+        fprintf(stderr, "Erreur lors de la construction.\n");
+        return -1;
+    }
+    printf("SA-IS, 1, %f, %.1f, oui\n", reference.time, (double) peakKb / 1024);
+
+    // Doublement des préfixes pour 1, 2, 4, ... threads, puis maxThreads.
+    int identical = 1;
+    for (int nbThreads = 1;; nbThreads *= 2) {
+        if (nbThreads > maxThreads) {
+            nbThreads = maxThreads;
+        }
+        struct buildResult result;
+        if (measureBuild(filename, nbThreads, &result, &peakKb) == -1) {
+            fprintf(stderr, "Erreur lors de la construction.\n");
+            return -1;
+        }
+        int same = result.hash == reference.hash;
+        identical = identical && same;
+        printf("doublement, %d, %f, %.1f, %s\n", nbThreads, result.time, (double) peakKb / 1024, same ? "oui" : "NON");
+        if (nbThreads == maxThreads) {
+            break;
+        }
+    }
+
+    return identical ? 0 : -1;
+}
@@ -0,0 +1,351 @@
+/**
+ * FICHIER:
+ * --------
+ * search.h
+ *
+ * DESCRIPTION:
+ * ------------
+ * Ce fichier contient la fonction search(), point d'entrée unique de la
+ * recherche exacte : elle choisit l'algorithme de exactSearchAlgos.h selon la
+ * longueur du mot, une estimation de la taille de l'alphabet (par
+ * échantillonnage du texte) et la longueur du texte.
+ *
+ * Le choix se fait dans une table de décision (profil de recherche), indexée
+ * par classe de taille d'alphabet et classe de longueur de mot. Un profil par
+ * défaut est fourni ; le programme calibrate mesure les algorithmes sur la
+ * machine et écrit un profil, que loadSearchProfile() charge.
+ *
+ * Format du fichier de profil (texte) :
+ *   petitTexte <longueur>
+ *   <alphabet max> <algo> ... <algo>     (SEARCH_LENGTH_CLASSES algos)
+ *   ...                                  (SEARCH_ALPHABET_CLASSES lignes)
+ * Les algorithmes sont désignés par leur numéro dans exactSearchAlgos.h.
+ *
+ * searchWordList() recherche une liste de mots de même longueur : mot par mot
+ * avec search() pour une liste courte, en une passe avec
+ * multiKarpRabinOccurrences() à partir de multiPatternMinWords() mots.
+ *
+ * AUTEUR:
+ * -------
+ * M. TAIA
+ */
+
+#ifndef SEARCH_H
+#define SEARCH_H
+
+////////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+////////////////////////////////////////////////////////////////////////////////
+#include "exactSearchAlgos.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINES
+////////////////////////////////////////////////////////////////////////////////
+// Nombre de classes de taille d'alphabet et de longueur de mot de la table.
+#define SEARCH_ALPHABET_CLASSES 4
+#define SEARCH_LENGTH_CLASSES 6
+
+// Nombre maximal de caractères du texte lus pour estimer l'alphabet.
+#define ALPHABET_SAMPLE_SIZE 4096
+
+// Fichier de profil écrit par calibrate.
+#define SEARCH_PROFILE_FILE "searchProfile.txt"
+
+////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Profil de recherche : table de décision de search().
+ * La classe d'alphabet est la première i telle que la taille estimée soit au
+ * plus alphabetLimits[i] (la dernière classe prend le reste), de même pour
+ * la longueur du mot avec lengthLimits. En dessous de smallText caractères,
+ * le prétraitement ne se rentabilise pas et on utilise l'algorithme naïf.
+ */
+struct searchProfile {
+    int smallText;
+    int alphabetLimits[SEARCH_ALPHABET_CLASSES];
+    int lengthLimits[SEARCH_LENGTH_CLASSES];
+    int algo[SEARCH_ALPHABET_CLASSES][SEARCH_LENGTH_CLASSES];
+};
+
+/**
+ * Donnée transmise à search() par searchWordList() pour chaque mot : la
+ * fonction de rappel de l'appelant, sa donnée et l'indice du mot courant.
+ */
+struct wordListReport {
+    multiOccurrenceCallback report;
+    void* data;
+    int wordIndex;
+    int stopped;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Variables globales
+////////////////////////////////////////////////////////////////////////////////
+// Profil courant. Les valeurs par défaut viennent de calibrate, sur une
+// machine x86-64 avec AVX2 (texte de 500000 caractères, alphabets de 2, 4, 20
+// et 70 lettres).
+struct searchProfile currentSearchProfile = {
+    33,
+    {2, 4, 20, 256},
+    {4, 8, 16, 32, 64, 1 << 30},
+    {
+        {13, 13, 13, 14, 14, 14},
+        {11, 11, 11, 14, 14, 14},
+        {11, 11, 11, 11, 14, 15},
+        {11, 11, 11, 11, 11, 11},
+    },
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Fonctions
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Fonction qui renvoie l'algorithme de numéro algoNum, s'il peut être appelé
+ * sans table fournie par l'appelant (signature de search()).
+ * Les algorithmes avec sentinelle (3 et 6) écrivent en text[textLength], hors
+ * du texte de l'appelant : ils ne sont pas proposés, ni à calibrate ni dans
+ * un profil.
+ *
+ * @param algoNum numéro de l'algorithme dans exactSearchAlgos.h.
+ * @return la fonction de recherche, ou NULL si l'algorithme demande des
+ *         tables précalculées, une sentinelle, ou n'existe pas.
+ */
+occurrenceSearch searchAlgorithm(int algoNum) {
+    switch (algoNum) {
+        case 1:
+            return &naifOccurrences;
+        case 2:
+            return &naifBoucleRapideOccurrences;
+        case 4:
+            return &naifStrncmpOccurrences;
+        case 5:
+            return &naifRapideStrncmpOccurrences;
+        case 11:
+            return &naifSimdOccurrences;
+        case 12:
+            return &twoWayOccurrences;
+        case 13:
+            return &shiftOrOccurrences;
+        case 14:
+            return &bndmOccurrences;
+        case 15:
+            return &bomOccurrences;
+        case 18:
+            return &karpRabinOccurrences;
+        case 21:
+            return &quickSearchOccurrences;
+        case 22:
+            return &raitaOccurrences;
+        case 23:
+            return &horspoolOptimiseOccurrences;
+        default:
+            return NULL;
+    }
+}
+
+/**
+ * Fonction qui estime la taille de l'alphabet d'un texte, en comptant les
+ * lettres distinctes d'au plus ALPHABET_SAMPLE_SIZE caractères répartis
+ * régulièrement dans le texte.
+ *
+ * @param text texte à échantillonner.
+ * @param textLength longueur du texte.
+ * @return le nombre de lettres distinctes de l'échantillon.
+ */
+int estimateAlphabetSize(char* text, ptrdiff_t textLength) {
+    unsigned char seen[256] = {0};
+    ptrdiff_t stride = textLength / ALPHABET_SAMPLE_SIZE + 1;
+    int distinct = 0;
+    for (ptrdiff_t i = 0; i < textLength; i += stride) {
+        unsigned char c = (unsigned char) text[i];
+        if (!seen[c]) {
+            seen[c] = 1;
+            distinct++;
+        }
+    }
+    return distinct;
+}
+
+/**
+ * Fonction qui choisit, dans le profil courant, le numéro de l'algorithme à
+ * utiliser.
+ *
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param alphabetSize taille estimée de l'alphabet.
+ * @return le numéro de l'algorithme.
+ */
+int chooseAlgorithm(ptrdiff_t textLength, int wordLength, int alphabetSize) {
+    struct searchProfile* profile = &currentSearchProfile;
+    if (textLength < profile->smallText) {
+        return 1;
+    }
+    int a = 0;
+    while (a < SEARCH_ALPHABET_CLASSES - 1 && alphabetSize > profile->alphabetLimits[a]) {
+        a++;
+    }
+    int l = 0;
+    while (l < SEARCH_LENGTH_CLASSES - 1 && wordLength > profile->lengthLimits[l]) {
+        l++;
+    }
+    return profile->algo[a][l];
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans un texte, avec
+ * l'algorithme choisi par le profil de recherche courant.
+ *
+ * @param text texte dans lequel rechercher le mot.
+ * @param word mot à rechercher dans le texte.
+ * @param textLength longueur du texte.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long search(char* text, char* word, ptrdiff_t textLength, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou le mot est NULL, on renvoie -2.
+    if (text == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+    int alphabetSize = estimateAlphabetSize(text, textLength);
+    occurrenceSearch algo = searchAlgorithm(chooseAlgorithm(textLength, wordLength, alphabetSize));
+    // Profil invalide : on se rabat sur l'algorithme naïf.
+    if (algo == NULL) {
+        algo = &naifOccurrences;
+    }
+    return algo(text, word, textLength, wordLength, report, data);
+}
+
+/**
+ * Fonction qui renvoie le nombre de mots à partir duquel la recherche
+ * multi-motifs en une passe est plus rapide que la recherche de chaque mot
+ * (voir multiKarpRabinOccurrences()).
+ *
+ * @param alphabetSize taille estimée de l'alphabet.
+ * @return le nombre minimal de mots.
+ */
+int multiPatternMinWords(int alphabetSize) {
+    return alphabetSize <= 4 ? MULTI_KARP_RABIN_MIN_WORDS_SMALL_ALPHABET : MULTI_KARP_RABIN_MIN_WORDS;
+}
+
+/**
+ * Fonction de rappel de search() utilisée par searchWordList() : transmet
+ * l'occurrence à la fonction de rappel de l'appelant, avec l'indice du mot.
+ *
+ * @param index indice du premier caractère de l'occurrence dans le texte.
+ * @param data pointeur vers la struct wordListReport du mot courant.
+ * @return 0 pour continuer la recherche, une autre valeur pour l'arrêter.
+ */
+int forwardWordOccurrence(ptrdiff_t index, void* data) {
+    struct wordListReport* wordReport = data;
+    wordReport->stopped = wordReport->report(wordReport->wordIndex, index, wordReport->data) != 0;
+    return wordReport->stopped;
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'une liste de mots de même
+ * longueur dans un texte. En dessous de multiPatternMinWords() mots, chaque
+ * mot est recherché par search() (les occurrences sont alors transmises mot
+ * par mot) ; au-delà, toute la liste est recherchée en une passe par
+ * multiKarpRabinOccurrences() (occurrences dans l'ordre du texte).
+ *
+ * @param text texte dans lequel rechercher les mots.
+ * @param textLength longueur du texte.
+ * @param words liste des mots à rechercher.
+ * @param wordCount nombre de mots de la liste.
+ * @param wordLength longueur commune des mots.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre total d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long searchWordList(char* text, ptrdiff_t textLength, char** words, int wordCount, int wordLength, multiOccurrenceCallback report, void* data) {
+    // Test d'erreur. Si le texte ou la liste est NULL, on renvoie -2.
+    if (text == NULL || words == NULL || wordCount <= 0 || wordLength <= 0) {
+        return -2;
+    }
+    if (wordCount >= multiPatternMinWords(estimateAlphabetSize(text, textLength))) {
+        return multiKarpRabinOccurrences(text, textLength, words, wordCount, wordLength, report, data);
+    }
+    struct wordListReport wordReport = {report, data, 0, 0};
+    long long count = 0;
+    for (int w = 0; w < wordCount && !wordReport.stopped; w++) {
+        wordReport.wordIndex = w;
+        long long wordOccurrences = search(text, words[w], textLength, wordLength,
+                                          report != NULL ? &forwardWordOccurrence : NULL, &wordReport);
+        // Test d'erreur. Si une recherche a échoué, on renvoie -2.
+        if (wordOccurrences < 0) {
+            return -2;
+        }
+        count += wordOccurrences;
+    }
+    return count;
+}
+
+/**
+ * Fonction qui charge un profil de recherche depuis un fichier (voir le
+ * format en tête de fichier) et en fait le profil courant.
+ * Le profil courant n'est pas modifié si le fichier est absent ou invalide.
+ *
+ * @param filename nom du fichier de profil.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int loadSearchProfile(const char* filename) {
+    FILE* file = fopen(filename, "r");
+    // Test d'erreur. Si l'ouverture a échoué, on renvoie -1.
+    if (file == NULL) {
+        return -1;
+    }
+    // Les limites de longueur ne sont pas dans le fichier.
+    struct searchProfile profile = currentSearchProfile;
+    int err = fscanf(file, " petitTexte %d", &profile.smallText) != 1;
+    for (int a = 0; a < SEARCH_ALPHABET_CLASSES && !err; a++) {
+        err = fscanf(file, "%d", &profile.alphabetLimits[a]) != 1;
+        for (int l = 0; l < SEARCH_LENGTH_CLASSES && !err; l++) {
+            err = fscanf(file, "%d", &profile.algo[a][l]) != 1 || searchAlgorithm(profile.algo[a][l]) == NULL;
+        }
+    }
+    fclose(file);
+    // Test d'erreur. Si le fichier est invalide, on renvoie -1.
+    if (err) {
+        return -1;
+    }
+    currentSearchProfile = profile;
+    return 0;
+}
+
+/**
+ * Fonction qui écrit un profil de recherche dans un fichier (voir le format
+ * en tête de fichier).
+ *
+ * @param filename nom du fichier de profil.
+ * @param profile profil à écrire.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int saveSearchProfile(const char* filename, struct searchProfile* profile) {
+    FILE* file = fopen(filename, "w");
+    // Test d'erreur. Si l'ouverture a échoué, on renvoie -1.
+    if (file == NULL) {
+        return -1;
+    }
+    fprintf(file, "petitTexte %d\n", profile->smallText);
+    for (int a = 0; a < SEARCH_ALPHABET_CLASSES; a++) {
+        fprintf(file, "%d", profile->alphabetLimits[a]);
+        for (int l = 0; l < SEARCH_LENGTH_CLASSES; l++) {
+            fprintf(file, " %d", profile->algo[a][l]);
+        }
+        fprintf(file, "\n");
+    }
+    // Test d'erreur. Si l'écriture a échoué, on renvoie -1.
+    if (fclose(file) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+#endif
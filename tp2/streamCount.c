@@ -0,0 +1,104 @@
+/**
+ * FICHIER:
+ * --------
+ * streamCount.c
+ *
+ * DESCRIPTION:
+ * ------------
+ * Programme qui compte les occurrences d'un mot dans l'entrée standard, lue
+ * par blocs avec un contexte de recherche de streamSearch.h. L'entrée peut
+ * être de longueur quelconque (tube, fichier de plusieurs Go) : la mémoire
+ * utilisée ne dépend que de la taille des blocs et de la longueur du mot.
+ *
+ * Exemple : cat texte.txt | ./streamCount motif 9 4096
+ *
+ * AUTEUR:
+ * -------
+ * M. TAIA
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+////////////////////////////////////////////////////////////////////////////////
+#include "streamSearch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// DEFINES
+////////////////////////////////////////////////////////////////////////////////
+// Taille des blocs lus par défaut.
+#define DEFAULT_BLOCK_SIZE 65536
+
+////////////////////////////////////////////////////////////////////////////////
+// Fonctions
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Fonction principale.
+ *
+ * @param argc nombre d'arguments.
+ * @param argv arguments.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int main(int argc, char** argv) {
+    // Test du nombre d'arguments.
+    if (argc < 2 || argc > 4) {
+        printf("Usage : %s word [algoNum] [blockSize]\n", argv[0]);
+        return -1;
+    }
+
+    // Récupération des arguments.
+    char* word = argv[1];
+    int wordLength = (int) strlen(word);
+    int algoNum = argc >= 3 ? atoi(argv[2]) : 9;
+    int blockSize = argc == 4 ? atoi(argv[3]) : DEFAULT_BLOCK_SIZE;
+
+    // Test des arguments.
+    if (wordLength == 0) {
+        fprintf(stderr, "Le mot ne doit pas être vide.\n");
+        return -1;
+    }
+    if (blockSize <= 0) {
+        fprintf(stderr, "La taille des blocs doit être strictement positive.\n");
+        return -1;
+    }
+
+    struct streamContext* context = createStreamContext(word, wordLength, algoNum);
+    char* block = malloc((size_t) blockSize);
+    // Test d'erreur. Si la création a échoué, on renvoie -1.
+    if (context == NULL || block == NULL) {
+        fprintf(stderr, "L'algorithme %d ne peut pas être utilisé sur un flux (7, 8, 9, 10, 16 ou 17).\n", algoNum);
+        freeStreamContext(context);
+        free(block);
+        return -1;
+    }
+
+    // Lecture et recherche, bloc par bloc.
+    long long count = 0;
+    size_t length;
+    while ((length = fread(block, 1, (size_t) blockSize, stdin)) > 0) {
+        long long result = streamSearch(context, block, (ptrdiff_t) length, NULL, NULL);
+        // Test d'erreur. Si la recherche a échoué, on renvoie -1.
+        if (result < 0) {
+            fprintf(stderr, "Erreur lors de la recherche.\n");
+            freeStreamContext(context);
+            free(block);
+            return -1;
+        }
+        count += result;
+    }
+    // Test d'erreur. Si la lecture a échoué, on renvoie -1.
+    if (ferror(stdin)) {
+        perror("fread");
+        freeStreamContext(context);
+        free(block);
+        return -1;
+    }
+
+    printf("%lld occurrences dans %lld caractères.\n", count, context->position);
+    freeStreamContext(context);
+    free(block);
+    return 0;
+}
@@ -0,0 +1,243 @@
+/**
+ * FICHIER:
+ * --------
+ * streamSearch.h
+ *
+ * DESCRIPTION:
+ * ------------
+ * Ce fichier contient la recherche d'un mot dans un flux : le texte arrive
+ * par blocs de tailles quelconques (lectures sur un tube ou une socket, par
+ * exemple), et un contexte de recherche conserve, d'un bloc au suivant, ce
+ * qu'il faut pour ne perdre aucune occurrence à cheval sur deux blocs. La
+ * mémoire utilisée ne dépend que de la longueur du mot.
+ *
+ * - Morris-Pratt (7) et Knuth-Morris-Pratt (8) sont des automates : le
+ *   contexte garde seulement l'état j (longueur du préfixe reconnu).
+ * - Les algorithmes à décalages (9, 10, 16, 17) gardent les wordLength - 1
+ *   derniers caractères du flux. À chaque bloc, on cherche d'abord les
+ *   occurrences qui commencent dans ces caractères (fenêtre de 2 *
+ *   (wordLength - 1) caractères au plus), puis celles du bloc lui-même, sans
+ *   le copier.
+ *
+ * Les positions sont comptées depuis le début du flux, sur des long long.
+ *
+ * AUTEUR:
+ * -------
+ * M. TAIA
+ */
+
+#ifndef STREAM_SEARCH_H
+#define STREAM_SEARCH_H
+
+////////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+////////////////////////////////////////////////////////////////////////////////
+#include "exactSearchAlgos.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Type des fonctions appelées pour chaque occurrence trouvée dans un flux.
+ * Renvoie 0 pour continuer la recherche, une autre valeur pour l'arrêter.
+ *
+ * @param position position du premier caractère de l'occurrence dans le flux.
+ * @param data donnée transmise par l'appelant.
+ */
+typedef int (*streamCallback)(long long position, void* data);
+
+/**
+ * Contexte de recherche dans un flux, créé par createStreamContext() et
+ * libéré par freeStreamContext().
+ */
+struct streamContext {
+    struct compiledPattern* pattern; // Mot et tables
+    int algoNum; // Numéro de l'algorithme
+    long long position; // Nombre de caractères du flux déjà lus
+    int state; // État j de MP/KMP
+    int tailLength; // Nombre de caractères dans tail
+    char* tail; // Derniers caractères du flux (wordLength - 1 au plus)
+    char* window; // Fenêtre de raccord (2 * (wordLength - 1) caractères)
+    int stopped; // 1 si report a demandé l'arrêt
+};
+
+/**
+ * Donnée transmise à streamReport() : traduit les indices d'un morceau en
+ * positions dans le flux.
+ */
+struct streamReportData {
+    streamCallback report;
+    void* data;
+    long long offset; // Position du morceau dans le flux
+    ptrdiff_t limit; // Seules les occurrences d'indice < limit sont retenues
+    long long count;
+    int stopped;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Fonctions
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Fonction qui crée un contexte de recherche de word dans un flux, avec
+ * l'algorithme algoNum (7, 8, 9, 10, 16 ou 17).
+ *
+ * @param word mot à rechercher.
+ * @param wordLength longueur du mot.
+ * @param algoNum numéro de l'algorithme.
+ * @return le contexte, ou NULL en cas d'erreur.
+ */
+struct streamContext* createStreamContext(char* word, int wordLength, int algoNum) {
+    // Test d'erreur. Si l'algorithme n'est pas disponible, on renvoie NULL.
+    if (algoNum != 7 && algoNum != 8 && algoNum != 9 && algoNum != 10 && algoNum != 16 && algoNum != 17) {
+        return NULL;
+    }
+    struct compiledPattern* pattern = compilePattern(word, wordLength);
+    // Test d'erreur. Si la compilation a échoué, on renvoie NULL.
+    if (pattern == NULL) {
+        return NULL;
+    }
+    // Le contexte, la queue et la fenêtre tiennent dans une allocation.
+    struct streamContext* context = malloc(sizeof(struct streamContext) + (size_t) 3 * (size_t) (wordLength - 1));
+    // Test d'erreur. Si l'allocation a échoué, on renvoie NULL.
+    if (context == NULL) {
+        perror("malloc");
+        freePattern(pattern);
+        return NULL;
+    }
+    context->pattern = pattern;
+    context->algoNum = algoNum;
+    context->position = 0;
+    context->state = 0;
+    context->tailLength = 0;
+    context->tail = (char*) (context + 1);
+    context->window = context->tail + wordLength - 1;
+    context->stopped = 0;
+    return context;
+}
+
+/**
+ * Fonction qui libère un contexte créé par createStreamContext().
+ *
+ * @param context contexte à libérer (ou NULL).
+ */
+void freeStreamContext(struct streamContext* context) {
+    if (context != NULL) {
+        freePattern(context->pattern);
+        free(context);
+    }
+}
+
+/**
+ * Fonction appelée pour chaque occurrence d'un morceau (fenêtre de raccord ou
+ * bloc) : filtre l'indice et le transmet, en position dans le flux, à la
+ * fonction de l'appelant.
+ *
+ * @param index indice de l'occurrence dans le morceau.
+ * @param data donnée (struct streamReportData*).
+ * @return 0 pour continuer, 1 si l'appelant demande l'arrêt.
+ */
+int streamReport(ptrdiff_t index, void* data) {
+    struct streamReportData* stream = (struct streamReportData*) data;
+    if (index >= stream->limit) {
+        return 0;
+    }
+    stream->count++;
+    if (stream->report != NULL && stream->report(stream->offset + index, stream->data) != 0) {
+        stream->stopped = 1;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Fonction qui recherche le mot dans le bloc suivant du flux.
+ * Les occurrences sont transmises dans l'ordre du flux ; celles qui
+ * commencent dans un bloc précédent et se terminent dans celui-ci sont
+ * comptées avec ce bloc. Après un arrêt demandé par report, les blocs
+ * suivants sont ignorés.
+ *
+ * @param context contexte de recherche.
+ * @param block bloc de texte.
+ * @param blockLength longueur du bloc.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long streamSearch(struct streamContext* context, char* block, ptrdiff_t blockLength, streamCallback report, void* data) {
+    // Test d'erreur. Si le contexte ou le bloc est NULL, on renvoie -2.
+    if (context == NULL || block == NULL || blockLength < 0) {
+        return -2;
+    }
+    if (context->stopped) {
+        return 0;
+    }
+    char* word = context->pattern->word;
+    int m = context->pattern->wordLength;
+    long long count = 0;
+
+    if (context->algoNum == 7 || context->algoNum == 8) {
+        // Automate de MP/KMP : on reprend à l'état j du bloc précédent.
+        int* table = context->algoNum == 7 ? context->pattern->bonPref : context->pattern->meilPref;
+        int j = context->state;
+        for (ptrdiff_t i = 0; i < blockLength; i++) {
+            while (j >= 0 && block[i] != word[j]) {
+                j = table[j];
+            }
+            j += 1;
+            if (j == m) {
+                count++;
+                j = table[m];
+                if (report != NULL && report(context->position + i - m + 1, data) != 0) {
+                    context->stopped = 1;
+                    break;
+                }
+            }
+        }
+        context->state = j;
+    } else {
+        struct streamReportData stream = {report, data, 0, 0, 0, 0};
+        // Occurrences qui commencent dans la queue : on cherche dans la queue
+        // suivie des m - 1 premiers caractères du bloc.
+        if (context->tailLength > 0) {
+            int head = blockLength < m - 1 ? (int) blockLength : m - 1;
+            memcpy(context->window, context->tail, (size_t) context->tailLength);
+            memcpy(context->window + context->tailLength, block, (size_t) head);
+            stream.offset = context->position - context->tailLength;
+            stream.limit = context->tailLength;
+            if (compiledOccurrences(context->pattern, context->algoNum, context->window, context->tailLength + head, &streamReport, &stream) == -2) {
+                return -2;
+            }
+        }
+        // Occurrences entièrement dans le bloc.
+        if (!stream.stopped) {
+            stream.offset = context->position;
+            stream.limit = PTRDIFF_MAX;
+            if (compiledOccurrences(context->pattern, context->algoNum, block, blockLength, &streamReport, &stream) == -2) {
+                return -2;
+            }
+        }
+        count = stream.count;
+        context->stopped = stream.stopped;
+
+        // Nouvelle queue : les m - 1 derniers caractères de queue + bloc.
+        if (blockLength >= m - 1) {
+            memcpy(context->tail, block + blockLength - (m - 1), (size_t) (m - 1));
+            context->tailLength = m - 1;
+        } else {
+            int keep = context->tailLength + blockLength > m - 1 ? m - 1 - (int) blockLength : context->tailLength;
+            memmove(context->tail, context->tail + context->tailLength - keep, (size_t) keep);
+            memcpy(context->tail + keep, block, (size_t) blockLength);
+            context->tailLength = keep + (int) blockLength;
+        }
+    }
+
+    context->position += blockLength;
+    return count;
+}
+
+#endif
@@ -0,0 +1,584 @@
+/**
+ * FICHIER:
+ * --------
+ * suffixArray.h
+ *
+ * DESCRIPTION:
+ * ------------
+ * Ce fichier contient un index du texte pour les recherches répétées : le
+ * tableau des suffixes, construit en temps linéaire par SA-IS (Nong, Zhang et
+ * Chan, tri induit), et les tableaux LCP qui accélèrent la recherche.
+ *
+ * - Le tableau des suffixes sa contient les positions des suffixes du texte
+ *   dans l'ordre lexicographique (octets non signés, un suffixe étant plus
+ *   petit que ceux dont il est préfixe).
+ * - Le tableau LCP (Kasai et al.) donne la longueur du plus long préfixe
+ *   commun de deux suffixes consécutifs de sa. Il sert à calculer les
+ *   tableaux lcpLeft et lcpRight de la recherche de Manber et Myers : pour
+ *   chaque milieu de la recherche dichotomique, la longueur du préfixe commun
+ *   avec chacune des deux bornes.
+ * - Les occurrences d'un mot sont les suffixes d'un intervalle de sa, trouvé
+ *   par deux recherches dichotomiques en O(m + log n) comparaisons de
+ *   caractères : aucun caractère du mot n'est comparé deux fois avec succès.
+ *
+ * La construction se fait une fois par texte ; chaque requête coûte ensuite
+ * O(m + log n), sans relire le texte. Les indices sont des saIndex : 32 bits
+ * par défaut (textes de moins de 2 Go ; 16 octets par caractère au plus
+ * pendant la construction, 12 ensuite), 64 bits si SUFFIX_ARRAY_64 est défini
+ * avant l'inclusion de ce fichier.
+ *
+ * AUTEUR:
+ * -------
+ * M. TAIA
+ */
+
+#ifndef SUFFIX_ARRAY_H
+#define SUFFIX_ARRAY_H
+
+////////////////////////////////////////////////////////////////////////////////
+// INCLUDES
+////////////////////////////////////////////////////////////////////////////////
+#include "exactSearchAlgos.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+////////////////////////////////////////////////////////////////////////////////
+// Types
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Type des indices du tableau des suffixes.
+ */
+#ifdef SUFFIX_ARRAY_64
+typedef int64_t saIndex;
+#define SA_INDEX_MAX INT64_MAX
+#else
+typedef int32_t saIndex;
+#define SA_INDEX_MAX INT32_MAX
+#endif
+
+/**
+ * Index d'un texte, créé par buildSuffixArray() et libéré par
+ * freeSuffixArray(). Le texte n'est pas copié : il doit rester valide tant
+ * que l'index est utilisé.
+ */
+struct suffixArray {
+    char* text; // Texte indexé
+    ptrdiff_t length; // Longueur du texte
+    saIndex* sa; // Positions des suffixes, dans l'ordre lexicographique
+    saIndex* lcpLeft; // lcpLeft[mid] : préfixe commun avec la borne gauche
+    saIndex* lcpRight; // lcpRight[mid] : préfixe commun avec la borne droite
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Fonctions
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Fonction qui renvoie le caractère i d'une chaîne de SA-IS.
+ * Au premier niveau, la chaîne est le texte suivi d'une sentinelle
+ * virtuelle : les octets sont décalés de 1 et la sentinelle vaut 0, plus
+ * petite que tous les caractères. Aux niveaux suivants, la chaîne réduite est
+ * un tableau de saIndex qui se termine déjà par sa sentinelle.
+ *
+ * @param s chaîne.
+ * @param i position du caractère.
+ * @param n longueur de la chaîne (sentinelle comprise).
+ * @param isText 1 au premier niveau, 0 ensuite.
+ * @return le caractère.
+ */
+static inline saIndex saisChar(const void* s, saIndex i, saIndex n, int isText) {
+    if (isText) {
+        return i == n - 1 ? 0 : (saIndex) ((const unsigned char*) s)[i] + 1;
+    }
+    return ((const saIndex*) s)[i];
+}
+
+/**
+ * Fonction qui renvoie le type du suffixe i (1 pour S, 0 pour L), rangé dans
+ * le tableau de bits types.
+ *
+ * @param types tableau de bits.
+ * @param i position du suffixe.
+ * @return le type.
+ */
+static inline int saisType(const unsigned char* types, saIndex i) {
+    return (types[i / 8] >> (i % 8)) & 1;
+}
+
+/**
+ * Fonction qui indique si le suffixe i est un suffixe LMS (de type S,
+ * précédé d'un suffixe de type L).
+ *
+ * @param types tableau de bits des types.
+ * @param i position du suffixe (peut être négative).
+ * @return 1 si le suffixe est LMS, 0 sinon.
+ */
+static inline int saisIsLMS(const unsigned char* types, saIndex i) {
+    return i > 0 && saisType(types, i) && !saisType(types, i - 1);
+}
+
+/**
+ * Fonction qui calcule le début (ou la fin) du seau de chaque caractère dans
+ * le tableau des suffixes.
+ *
+ * @param s chaîne.
+ * @param buckets début ou fin de chaque seau (résultat, k + 1 cases).
+ * @param n longueur de la chaîne.
+ * @param k plus grand caractère.
+ * @param isText 1 au premier niveau, 0 ensuite.
+ * @param end 1 pour la fin des seaux, 0 pour leur début.
+ */
+void saisBuckets(const void* s, saIndex* buckets, saIndex n, saIndex k, int isText, int end) {
+    for (saIndex c = 0; c <= k; c++) {
+        buckets[c] = 0;
+    }
+    for (saIndex i = 0; i < n; i++) {
+        buckets[saisChar(s, i, n, isText)]++;
+    }
+    saIndex sum = 0;
+    for (saIndex c = 0; c <= k; c++) {
+        sum += buckets[c];
+        buckets[c] = end ? sum : sum - buckets[c];
+    }
+}
+
+/**
+ * Fonction qui place les suffixes de type L à partir des suffixes déjà
+ * placés (parcours de gauche à droite, début des seaux), puis les suffixes
+ * de type S (parcours de droite à gauche, fin des seaux) : tri induit.
+ *
+ * @param s chaîne.
+ * @param sa tableau des suffixes.
+ * @param types tableau de bits des types.
+ * @param buckets tableau de k + 1 cases.
+ * @param n longueur de la chaîne.
+ * @param k plus grand caractère.
+ * @param isText 1 au premier niveau, 0 ensuite.
+ */
+void saisInduce(const void* s, saIndex* sa, const unsigned char* types, saIndex* buckets, saIndex n, saIndex k, int isText) {
+    saisBuckets(s, buckets, n, k, isText, 0);
+    for (saIndex i = 0; i < n; i++) {
+        saIndex j = sa[i] - 1;
+        if (j >= 0 && !saisType(types, j)) {
+            sa[buckets[saisChar(s, j, n, isText)]++] = j;
+        }
+    }
+    saisBuckets(s, buckets, n, k, isText, 1);
+    for (saIndex i = n - 1; i >= 0; i--) {
+        saIndex j = sa[i] - 1;
+        if (j >= 0 && saisType(types, j)) {
+            sa[--buckets[saisChar(s, j, n, isText)]] = j;
+        }
+    }
+}
+
+/**
+ * Fonction qui construit le tableau des suffixes d'une chaîne terminée par
+ * une sentinelle unique et minimale (SA-IS).
+ * Les suffixes LMS sont triés par tri induit sur leurs sous-chaînes, puis
+ * renommés ; si deux sous-chaînes LMS sont égales, la chaîne des noms (au
+ * plus n / 2 caractères) est triée récursivement dans la fin de sa. Le tri
+ * induit à partir des suffixes LMS triés donne enfin tout le tableau.
+ *
+ * @param s chaîne.
+ * @param sa tableau des suffixes (résultat, n cases).
+ * @param n longueur de la chaîne (sentinelle comprise).
+ * @param k plus grand caractère.
+ * @param isText 1 au premier niveau, 0 ensuite.
+ * @return 0 en cas de succès, -1 sinon.
+ */
+int sais(const void* s, saIndex* sa, saIndex n, saIndex k, int isText) {
+    unsigned char* types = calloc((size_t) n / 8 + 1, 1);
+    saIndex* buckets = malloc(sizeof(saIndex) * (size_t) (k + 1));
+    // Test d'erreur. Si une allocation a échoué, on renvoie -1.
+    if (types == NULL || buckets == NULL) {
+        perror("malloc");
+        free(types);
+        free(buckets);
+        return -1;
+    }
+
+    // Types des suffixes : la sentinelle est de type S, son prédécesseur de
+    // type L.
+    types[(n - 1) / 8] |= (unsigned char) (1 << ((n - 1) % 8));
+    for (saIndex i = n - 3; i >= 0; i--) {
+        saIndex c = saisChar(s, i, n, isText);
+        saIndex next = saisChar(s, i + 1, n, isText);
+        if (c < next || (c == next && saisType(types, i + 1))) {
+            types[i / 8] |= (unsigned char) (1 << (i % 8));
+        }
+    }
+
+    // Étape 1 : tri des sous-chaînes LMS.
+    saisBuckets(s, buckets, n, k, isText, 1);
+    for (saIndex i = 0; i < n; i++) {
+        sa[i] = -1;
+    }
+    for (saIndex i = 1; i < n; i++) {
+        if (saisIsLMS(types, i)) {
+            sa[--buckets[saisChar(s, i, n, isText)]] = i;
+        }
+    }
+    saisInduce(s, sa, types, buckets, n, k, isText);
+
+    // Les suffixes LMS triés sont rangés au début de sa.
+    saIndex n1 = 0;
+    for (saIndex i = 0; i < n; i++) {
+        if (saisIsLMS(types, sa[i])) {
+            sa[n1++] = sa[i];
+        }
+    }
+    // Noms des sous-chaînes LMS, rangés à la position (pos / 2) de la fin de
+    // sa : deux suffixes LMS sont distants d'au moins 2.
+    for (saIndex i = n1; i < n; i++) {
+        sa[i] = -1;
+    }
+    saIndex name = 0;
+    saIndex prev = -1;
+    for (saIndex i = 0; i < n1; i++) {
+        saIndex pos = sa[i];
+        int diff = 0;
+        for (saIndex d = 0; d < n; d++) {
+            if (prev == -1 || saisChar(s, pos + d, n, isText) != saisChar(s, prev + d, n, isText)
+                || saisType(types, pos + d) != saisType(types, prev + d)) {
+                diff = 1;
+                break;
+            }
+            if (d > 0 && (saisIsLMS(types, pos + d) || saisIsLMS(types, prev + d))) {
+                break;
+            }
+        }
+        if (diff) {
+            name++;
+            prev = pos;
+        }
+        sa[n1 + pos / 2] = name - 1;
+    }
+    for (saIndex i = n - 1, j = n - 1; i >= n1; i--) {
+        if (sa[i] >= 0) {
+            sa[j--] = sa[i];
+        }
+    }
+
+    // Étape 2 : tri des suffixes LMS, récursif si des noms sont égaux.
+    saIndex* sa1 = sa;
+    saIndex* s1 = sa + n - n1;
+    if (name < n1) {
+        if (sais(s1, sa1, n1, name - 1, 0) == -1) {
+            free(types);
+            free(buckets);
+            return -1;
+        }
+    } else {
+        for (saIndex i = 0; i < n1; i++) {
+            sa1[s1[i]] = i;
+        }
+    }
+
+    // Étape 3 : tri induit à partir des suffixes LMS triés.
+    saisBuckets(s, buckets, n, k, isText, 1);
+    for (saIndex i = 1, j = 0; i < n; i++) {
+        if (saisIsLMS(types, i)) {
+            s1[j++] = i;
+        }
+    }
+    for (saIndex i = 0; i < n1; i++) {
+        sa1[i] = s1[sa1[i]];
+    }
+    for (saIndex i = n1; i < n; i++) {
+        sa[i] = -1;
+    }
+    for (saIndex i = n1 - 1; i >= 0; i--) {
+        saIndex j = sa[i];
+        sa[i] = -1;
+        sa[--buckets[saisChar(s, j, n, isText)]] = j;
+    }
+    saisInduce(s, sa, types, buckets, n, k, isText);
+
+    free(types);
+    free(buckets);
+    return 0;
+}
+
+/**
+ * Fonction qui construit le tableau des suffixes d'un texte avec SA-IS.
+ *
+ * @param text texte.
+ * @param textLength longueur du texte (au plus SA_INDEX_MAX - 1).
+ * @return le tableau des suffixes (textLength cases, à libérer par free()),
+ *         ou NULL en cas d'erreur.
+ */
+saIndex* suffixArrayOf(char* text, ptrdiff_t textLength) {
+    // Test d'erreur. Si le texte est trop long pour les saIndex, on renvoie
+    // NULL.
+    if (text == NULL || textLength < 0 || textLength >= SA_INDEX_MAX) {
+        return NULL;
+    }
+    // Une case de plus pour la sentinelle, toujours en tête de sa.
+    saIndex n = (saIndex) textLength + 1;
+    saIndex* sa = malloc(sizeof(saIndex) * (size_t) n);
+    // Test d'erreur. Si l'allocation a échoué, on renvoie NULL.
+    if (sa == NULL) {
+        perror("malloc");
+        return NULL;
+    }
+    if (n == 1) {
+        return sa;
+    }
+    if (sais(text, sa, n, 256, 1) == -1) {
+        free(sa);
+        return NULL;
+    }
+    memmove(sa, sa + 1, sizeof(saIndex) * (size_t) (n - 1));
+    return sa;
+}
+
+/**
+ * Fonction qui calcule le tableau LCP d'un texte (algorithme de Kasai et
+ * al.) : lcp[i] est la longueur du plus long préfixe commun des suffixes
+ * sa[i - 1] et sa[i], et lcp[0] vaut 0.
+ * Les suffixes sont parcourus dans l'ordre du texte : le préfixe commun
+ * diminue d'au plus 1 d'un suffixe au suivant, d'où un temps linéaire.
+ *
+ * @param text texte.
+ * @param textLength longueur du texte.
+ * @param sa tableau des suffixes du texte.
+ * @return le tableau LCP (textLength cases, à libérer par free()), ou NULL
+ *         en cas d'erreur.
+ */
+saIndex* lcpArrayOf(char* text, ptrdiff_t textLength, saIndex* sa) {
+    saIndex n = (saIndex) textLength;
+    saIndex* lcp = malloc(sizeof(saIndex) * (size_t) (n + 1));
+    saIndex* rank = malloc(sizeof(saIndex) * (size_t) (n + 1));
+    // Test d'erreur. Si une allocation a échoué, on renvoie NULL.
+    if (lcp == NULL || rank == NULL) {
+        perror("malloc");
+        free(lcp);
+        free(rank);
+        return NULL;
+    }
+    for (saIndex i = 0; i < n; i++) {
+        rank[sa[i]] = i;
+    }
+    saIndex h = 0;
+    for (saIndex i = 0; i < n; i++) {
+        if (rank[i] == 0) {
+            lcp[0] = 0;
+            h = 0;
+            continue;
+        }
+        saIndex j = sa[rank[i] - 1];
+        while (i + h < n && j + h < n && text[i + h] == text[j + h]) {
+            h++;
+        }
+        lcp[rank[i]] = h;
+        if (h > 0) {
+            h--;
+        }
+    }
+    free(rank);
+    return lcp;
+}
+
+/**
+ * Fonction qui remplit lcpLeft et lcpRight pour l'intervalle ]left, right[
+ * de la recherche dichotomique, et renvoie le préfixe commun des suffixes
+ * sa[left] et sa[right].
+ * Les bornes virtuelles -1 et n (avant le premier et après le dernier
+ * suffixe) n'ont aucun préfixe commun avec les autres suffixes.
+ *
+ * @param index index en construction.
+ * @param lcp tableau LCP.
+ * @param left borne gauche.
+ * @param right borne droite.
+ * @return le préfixe commun de sa[left] et sa[right].
+ */
+saIndex fillLcpLR(struct suffixArray* index, saIndex* lcp, saIndex left, saIndex right) {
+    saIndex n = (saIndex) index->length;
+    if (right - left == 1) {
+        return left < 0 || right >= n ? 0 : lcp[right];
+    }
+    saIndex mid = left + (right - left) / 2;
+    index->lcpLeft[mid] = fillLcpLR(index, lcp, left, mid);
+    index->lcpRight[mid] = fillLcpLR(index, lcp, mid, right);
+    if (left < 0 || right >= n) {
+        return 0;
+    }
+    return index->lcpLeft[mid] < index->lcpRight[mid] ? index->lcpLeft[mid] : index->lcpRight[mid];
+}
+
+/**
+ * Fonction qui libère un index créé par buildSuffixArray().
+ *
+ * @param index index à libérer (ou NULL).
+ */
+void freeSuffixArray(struct suffixArray* index) {
+    if (index != NULL) {
+        free(index->sa);
+        free(index->lcpLeft);
+        free(index->lcpRight);
+        free(index);
+    }
+}
+
+/**
+ * Fonction qui construit l'index d'un texte : tableau des suffixes (SA-IS),
+ * tableau LCP (Kasai), puis tableaux lcpLeft et lcpRight de la recherche.
+ *
+ * @param text texte à indexer.
+ * @param textLength longueur du texte (au plus SA_INDEX_MAX - 1).
+ * @return l'index, ou NULL en cas d'erreur.
+ */
+struct suffixArray* buildSuffixArray(char* text, ptrdiff_t textLength) {
+    struct suffixArray* index = calloc(1, sizeof(struct suffixArray));
+    // Test d'erreur. Si l'allocation a échoué, on renvoie NULL.
+    if (index == NULL) {
+        perror("calloc");
+        return NULL;
+    }
+    index->text = text;
+    index->length = textLength;
+    index->sa = suffixArrayOf(text, textLength);
+    if (index->sa == NULL) {
+        freeSuffixArray(index);
+        return NULL;
+    }
+    saIndex* lcp = lcpArrayOf(text, textLength, index->sa);
+    index->lcpLeft = malloc(sizeof(saIndex) * (size_t) (textLength + 1));
+    index->lcpRight = malloc(sizeof(saIndex) * (size_t) (textLength + 1));
+    // Test d'erreur. Si une allocation a échoué, on renvoie NULL.
+    if (lcp == NULL || index->lcpLeft == NULL || index->lcpRight == NULL) {
+        free(lcp);
+        freeSuffixArray(index);
+        return NULL;
+    }
+    fillLcpLR(index, lcp, -1, (saIndex) textLength);
+    free(lcp);
+    return index;
+}
+
+/**
+ * Fonction qui renvoie le rang du premier suffixe supérieur au mot
+ * (recherche de Manber et Myers).
+ * Le mot est complété par un caractère plus petit que tous les autres
+ * (upper = 0 : premier suffixe dont le mot est préfixe, ou qui lui est
+ * supérieur), ou plus grand (upper = 1 : premier suffixe qui suit tous ceux
+ * dont le mot est préfixe). leftLcp et rightLcp sont les préfixes communs du
+ * mot avec les bornes : quand lcpLeft[mid] (ou lcpRight[mid]) en diffère, le
+ * milieu est placé sans lire le texte, sinon la comparaison reprend après
+ * les caractères déjà égaux.
+ *
+ * @param index index du texte.
+ * @param word mot.
+ * @param wordLength longueur du mot.
+ * @param upper 0 pour la borne inférieure, 1 pour la borne supérieure.
+ * @return le rang (entre 0 et la longueur du texte).
+ */
+saIndex suffixArrayBound(struct suffixArray* index, char* word, int wordLength, int upper) {
+    const unsigned char* text = (const unsigned char*) index->text;
+    const unsigned char* w = (const unsigned char*) word;
+    saIndex n = (saIndex) index->length;
+    saIndex left = -1;
+    saIndex right = n;
+    saIndex leftLcp = 0;
+    saIndex rightLcp = 0;
+
+    while (right - left > 1) {
+        saIndex mid = left + (right - left) / 2;
+        saIndex h;
+        if (leftLcp >= rightLcp) {
+            if (index->lcpLeft[mid] > leftLcp) {
+                left = mid;
+                continue;
+            }
+            if (index->lcpLeft[mid] < leftLcp) {
+                right = mid;
+                rightLcp = index->lcpLeft[mid];
+                continue;
+            }
+            h = leftLcp;
+        } else {
+            if (index->lcpRight[mid] > rightLcp) {
+                right = mid;
+                continue;
+            }
+            if (index->lcpRight[mid] < rightLcp) {
+                left = mid;
+                leftLcp = index->lcpRight[mid];
+                continue;
+            }
+            h = rightLcp;
+        }
+        // Comparaison du mot et du suffixe à partir du caractère h.
+        saIndex pos = index->sa[mid];
+        while (h < wordLength && pos + h < n && w[h] == text[pos + h]) {
+            h++;
+        }
+        int suffixIsSmaller;
+        if (h == wordLength) {
+            suffixIsSmaller = upper;
+        } else if (pos + h == n) {
+            suffixIsSmaller = 1;
+        } else {
+            suffixIsSmaller = text[pos + h] < w[h];
+        }
+        if (suffixIsSmaller) {
+            left = mid;
+            leftLcp = h;
+        } else {
+            right = mid;
+            rightLcp = h;
+        }
+    }
+    return right;
+}
+
+/**
+ * Fonction qui compte les occurrences d'un mot dans le texte indexé.
+ *
+ * @param index index du texte.
+ * @param word mot à rechercher.
+ * @param wordLength longueur du mot.
+ * @return le nombre d'occurrences, ou -2 en cas d'erreur.
+ */
+long long suffixArrayCount(struct suffixArray* index, char* word, int wordLength) {
+    // Test d'erreur. Si l'index ou le mot est NULL, on renvoie -2.
+    if (index == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+    return (long long) suffixArrayBound(index, word, wordLength, 1) - suffixArrayBound(index, word, wordLength, 0);
+}
+
+/**
+ * Fonction qui recherche toutes les occurrences d'un mot dans le texte
+ * indexé. Les occurrences sont transmises dans l'ordre des suffixes, et non
+ * dans l'ordre du texte.
+ *
+ * @param index index du texte.
+ * @param word mot à rechercher.
+ * @param wordLength longueur du mot.
+ * @param report fonction appelée pour chaque occurrence (ou NULL).
+ * @param data donnée transmise à report.
+ * @return le nombre d'occurrences trouvées, ou -2 en cas d'erreur.
+ */
+long long suffixArrayLocate(struct suffixArray* index, char* word, int wordLength, occurrenceCallback report, void* data) {
+    // Test d'erreur. Si l'index ou le mot est NULL, on renvoie -2.
+    if (index == NULL || word == NULL || wordLength <= 0) {
+        return -2;
+    }
+    saIndex first = suffixArrayBound(index, word, wordLength, 0);
+    saIndex last = suffixArrayBound(index, word, wordLength, 1);
+    if (report != NULL) {
+        for (saIndex i = first; i < last; i++) {
+            if (report(index->sa[i], data) != 0) {
+                return (long long) (i - first) + 1;
+            }
+        }
+    }
+    return (long long) last - first;
+}
+
+#endif
@@ -40,8 +40,8 @@
  * @return le mot généré.
  */
 char* generateWord(int wordLength, int alphabetSize) {
-    // Allocation de la mémoire pour le mot.
-    char* word = (char*) malloc((long unsigned int) wordLength * sizeof(char));
+    // Allocation de la mémoire pour le mot (et le caractère de fin de chaîne).
+    char* word = (char*) malloc((long unsigned int) (wordLength + 1) * sizeof(char));
     // Test d'erreur. Si l'allocation a échoué, on renvoie NULL.
     if (word == NULL) {
         return NULL;
@@ -49,7 +49,8 @@ char* generateWord(int wordLength, int alphabetSize) {
 
     // Génération du mot.
     for (int i = 0; i < wordLength; i++) {
-        word[i] = (char) (rand() % alphabetSize + 'A');
+        // Même alphabet que singleStringText_generator.
+        word[i] = (char) (rand() % alphabetSize + '!');
     }
     // Insertion du caractère de fin de chaîne.
     word[wordLength] = '\0';
@@ -27,6 +27,9 @@
 #include <math.h>
 #include <string.h>
 
+#include "mappedText.h"
+#include "trieStats.h"
+
 
 ////////////////////////////////////////////////////////////////////////////////
 // DEFINES
@@ -41,6 +44,7 @@
 #define QUEUE_SIZE 1000000
 
 
+
 ////////////////////////////////////////////////////////////////////////////////
 // STRUCTURES
 ////////////////////////////////////////////////////////////////////////////////
@@ -295,6 +299,70 @@ void printTrie(Trie trie) {
     }
 }
 
+
+/**
+ * DESCRIPTION:
+ *  Statistiques de forme et d'occupation mémoire d'un trie à table de
+ *   hachage. Les noeuds de départ obtenus par hachage comptent comme noeuds.
+ * ARGUMENTS:
+ *  Trie trie : un trie.
+ *  TrieStats *stats : les statistiques à remplir.
+ * RETURN:
+ *  0 en cas de succès, -1 en cas d'erreur.
+ */
+int trieStats(Trie trie, TrieStats *stats) {
+    memset(stats, 0, sizeof(TrieStats));
+    int size = (int) (trie->maxNode * FILL_RATE);
+    // Les identifiants de noeuds sont les indices créés et les alvéoles
+    int idCount = trie->nextNode > size ? trie->nextNode : size;
+    // Père et nombre de fils de chaque noeud, et existence des noeuds
+    int *parent = malloc((size_t) idCount * sizeof(int));
+    int *children = calloc((size_t) idCount, sizeof(int));
+    char *exists = calloc((size_t) idCount, sizeof(char));
+    if (parent == NULL || children == NULL || exists == NULL) {
+        perror("Erreur d'allocation mémoire");
+        free(parent);
+        free(children);
+        free(exists);
+        return -1;
+    }
+    memset(parent, -1, (size_t) idCount * sizeof(int));
+    memset(exists, 1, (size_t) trie->nextNode * sizeof(char));
+
+    // Parcours des alvéoles de la table de hachage
+    for (int i = 0; i < size; i++) {
+        int chain = 0;
+        for (List currentList = trie->transition[i]; currentList != NULL; currentList = currentList->next) {
+            chain++;
+            children[currentList->startNode]++;
+            exists[currentList->startNode] = 1;
+            parent[currentList->targetNode] = currentList->startNode;
+        }
+        stats->transitionCount += chain;
+        stats->chainLength[chain < STATS_MAX_CHAIN ? chain : STATS_MAX_CHAIN - 1]++;
+    }
+    for (int i = 0; i < idCount; i++) {
+        if (exists[i]) {
+            stats->nodeCount++;
+            stats->fanOut[children[i] < ALPHABET_SIZE ? children[i] : ALPHABET_SIZE]++;
+        }
+    }
+
+    // Les alvéoles, un maillon par transition, un état terminal et un
+    //  suppléant par noeud
+    size_t fixedBytes = sizeof(struct _trie) + (size_t) size * sizeof(List) \
+        + (size_t) stats->transitionCount * sizeof(struct _list);
+    size_t nodeBytes = sizeof(char) + sizeof(int);
+    stats->bytesAllocated = fixedBytes + (size_t) size * nodeBytes;
+    stats->bytesUsed = fixedBytes + (size_t) stats->nodeCount * nodeBytes;
+
+    int err = fillDepthStats(parent, exists, idCount, stats);
+    free(parent);
+    free(children);
+    free(exists);
+    return err;
+}
+
 /**
  * DESCRIPTION:
  *  Extraction de préfixe.
@@ -533,16 +601,17 @@ void calcSupp(Trie trie, Queue queue) {
  * ARGUMENTS:
  *  Trie trie : un trie
  *  unsigned char *text : un texte
+ *  size_t textLength : la longueur du texte
  * RETURN:
  *  Le nombre total d'occurences de mots du trie dans le texte
  */
-int countWordsInText(Trie trie, unsigned char *text) {
+long long countWordsInText(Trie trie, unsigned char *text, size_t textLength) {
     // Initialiser le compteur d'occurences
-    int count = 0;
+    long long count = 0;
     // Initialiser le noeud courant
     int currentNode = 0;
     // Pour chaque lettre du texte
-    for (int i = 0; text[i] != '\0'; i++) {
+    for (size_t i = 0; i < textLength; i++) {
         // Récupérer la liste d'adjacence du noeud courant
         List currentList = trie->transition[currentNode];
         // Initialiser le prochain noeud à -1 (pas de transition)
@@ -622,6 +691,12 @@ int main(int argc, char **argv) {
     }
     printTrie(trie);
 
+    // Statistiques du trie
+    TrieStats stats;
+    if (trieStats(trie, &stats) == 0) {
+        printTrieStats(&stats);
+    }
+
     // Fermer le fichier de mots
     fclose(wordFile);
 
@@ -637,30 +712,19 @@ int main(int argc, char **argv) {
     printf("\n\n\n\n");
     printTrie(trie);
 
-    // Ouvrir le fichier de texte
-    FILE *textFile = fopen(argv[2], "r");
-    // Test d'erreur
-    if (textFile == NULL) {
-        perror("Erreur d'ouverture du fichier de texte");
-        return EXIT_FAILURE;
-    }
-
-    // Lire le texte du fichier
-    unsigned char text[1000];
-    success = fscanf(textFile, "%s", text);
-    if (success == EOF) {
+    // Projeter le fichier de texte en mémoire (sans copie ni troncature)
+    struct mappedText mapped;
+    if (mapText(argv[2], 0, MAPPED_TEXT_HUGE_PAGES, &mapped) == -1) {
         fprintf(stderr, "Erreur de lecture du texte\n");
         return EXIT_FAILURE;
     }
 
-    // Fermer le fichier de texte
-    fclose(textFile);
-
     // Compter le nombre d'occurences de mots du trie dans le texte
-    int count = countWordsInText(trie, text);
+    long long count = countWordsInText(trie, (unsigned char *) mapped.text, mapped.length);
+    unmapText(&mapped);
 
     // Afficher le résultat
-    printf("Nombre d'occurences de mots du trie dans le texte: %d\n", count);
+    printf("Nombre d'occurences de mots du trie dans le texte: %lld\n", count);
 
     // Libérer la mémoire
     freeTrie(trie);
@@ -5,6 +5,8 @@
 #include <math.h>
 #include <string.h>
 
+#include "trieStats.h"
+
 
 // Macros //////////////////////////////////////////////////////////////////////
 // Taille de l'alphabet égal à UCHAR_MAX
@@ -13,6 +15,7 @@
 #define FILL_RATE 0.75
 
 
+
 ////////////////////////////////////////////////////////////////////////////////
 // STRUCTURES
 ////////////////////////////////////////////////////////////////////////////////
@@ -212,6 +215,57 @@ void printTrie(Trie trie) {
 }
 
 
+/**
+ * DESCRIPTION:
+ *  Statistiques de forme et d'occupation mémoire d'un trie à table de
+ *   transitions. Il n'y a pas de table de hachage : l'histogramme des
+ *   longueurs de chaînes reste vide.
+ * ARGUMENTS:
+ *  Trie trie : un trie à table de transitions.
+ *  TrieStats *stats : les statistiques à remplir.
+ * RETURN:
+ *  0 en cas de succès, -1 en cas d'erreur.
+ */
+int trieStats(Trie trie, TrieStats *stats) {
+    memset(stats, 0, sizeof(TrieStats));
+    // La racine existe même avant la première insertion
+    int nodeCount = trie->nextNode > 0 ? trie->nextNode : 1;
+    // Père de chaque noeud
+    int *parent = malloc((size_t) nodeCount * sizeof(int));
+    if (parent == NULL) {
+        perror("Erreur d'allocation mémoire");
+        return -1;
+    }
+    memset(parent, -1, (size_t) nodeCount * sizeof(int));
+
+    // Parcours des lignes de la table de transitions des noeuds créés
+    for (int i = 0; i < nodeCount; i++) {
+        int children = 0;
+        for (int j = 0; j < ALPHABET_SIZE; j++) {
+            int target = trie->transitions[i][j];
+            if (target != -1) {
+                children++;
+                if (target < nodeCount && target != i) {
+                    parent[target] = i;
+                }
+            }
+        }
+        stats->transitionCount += children;
+        stats->fanOut[children]++;
+    }
+    stats->nodeCount = nodeCount;
+
+    // Une ligne de transitions et un état terminal par noeud
+    size_t nodeBytes = sizeof(int *) + ALPHABET_SIZE * sizeof(int) + sizeof(char);
+    stats->bytesAllocated = sizeof(struct _trie) + (size_t) trie->maxNode * nodeBytes;
+    stats->bytesUsed = sizeof(struct _trie) + (size_t) nodeCount * nodeBytes;
+
+    int err = fillDepthStats(parent, NULL, nodeCount, stats);
+    free(parent);
+    return err;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // AHO-CORASICK
 ////////////////////////////////////////////////////////////////////////////////